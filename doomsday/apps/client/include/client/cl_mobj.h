@@ -27,6 +27,9 @@
 /// Asserts that a given mobj is a client mobj.
 #define CL_ASSERT_CLMOBJ(mo)    DENG_ASSERT(Cl_IsClientMobj(mo));
 
+/// Playout delay (seconds) for drawing remote mobjs. Zero disables interpolation.
+extern float clMobjPlayoutDelay;
+
 /**
  * Make the real player mobj identical with the client mobj.
  * The client mobj is always unlinked. Only the *real* mobj is visible.
@@ -75,6 +78,33 @@ void ClMobj_ReadDelta();
  */
 void ClMobj_ReadNullDelta();
 
+/**
+ * Advances the clock used for drawing remote mobjs. The clock follows the server's
+ * game time, as received in frame packets.
+ *
+ * @param ticLength  Length of the tick in seconds.
+ */
+void ClMobj_AdvancePlayout(timespan_t ticLength);
+
+/**
+ * Determines the origin of a remote, non-player client mobj at the current playout
+ * time by interpolating between the movement snapshots received from the server.
+ *
+ * @param mob     Client mobj.
+ * @param origin  The origin is written here (only if @c true is returned).
+ *
+ * @return @c true, if the origin was determined.
+ */
+bool ClMobj_OriginSmoothed(mobj_t *mob, coord_t origin[3]);
+
+/**
+ * Determines the angle of a remote, non-player client mobj at the current playout
+ * time.
+ *
+ * @return @c true, if the angle was determined.
+ */
+bool ClMobj_AngleSmoothed(mobj_t *mob, angle_t *angle);
+
 /**
  * Determines whether a mobj is a client mobj.
  *
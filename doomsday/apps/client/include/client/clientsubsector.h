@@ -71,6 +71,25 @@ public:
      */
     bool hasWorldVolume(bool useSmoothedHeights = true) const;
 
+    /**
+     * Returns a counter that is incremented whenever something that affects the shape
+     * of the wall geometry around the subsector changes (e.g., plane heights, materials,
+     * or line flags). Used for validating cached geometry.
+     */
+    de::duint geometryVersion() const;
+
+    /**
+     * Returns the sum of the geometry versions of all the subsectors of @a sector
+     * (which may be @c nullptr). The sum changes whenever any of them changes.
+     */
+    static de::duint sectorGeometryVersion(Sector const *sector);
+
+    /**
+     * Returns the sum of the geometry versions of the sectors on both sides of all the
+     * lines around a vertex, starting from the line owner @a base.
+     */
+    static de::duint vertexGeometryVersion(LineOwner const &base);
+
 //- Edge loops --------------------------------------------------------------------------
 
     // Edge loop identifiers:
@@ -125,6 +144,15 @@ public:
      */
     void markReverbDirty(bool yes = true);
 
+    /**
+     * Recalculate the environmental audio characteristics of the subsector right away,
+     * using the current audio environments of the surrounding subspaces (which are not
+     * updated). Different subsectors can be updated concurrently.
+     *
+     * @see Map::initReverb()
+     */
+    void updateReverbFromSubspaces();
+
 #if 0
 //- Bias lighting ----------------------------------------------------------------------
 
@@ -174,10 +202,18 @@ public:
     bool hasDecorations() const;
 
     /**
-     * Perform scheduled decoration work.
+     * Perform scheduled decoration work. Surfaces needing new decorations have their
+     * decoration patterns queued; the decorations themselves are created by the next
+     * call to plotQueuedDecorations().
      */
     void decorate();
 
+    /**
+     * Plot all the decoration patterns queued by decorate(), as one batch for all
+     * subsectors. The patterns are plotted concurrently.
+     */
+    static void plotQueuedDecorations();
+
     /**
      * Mark the surface as needing a decoration update.
      */
@@ -0,0 +1,72 @@
+/** @file tictimings.h  Per-tic timing statistics for benchmarking.
+ *
+ * @authors Copyright © 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef DENG_MISC_TICTIMINGS_H
+#define DENG_MISC_TICTIMINGS_H
+
+#include "dd_types.h"
+
+/**
+ * Measured parts of a tic.
+ */
+typedef enum tictiming_e {
+    TICTIME_THINKERS,       ///< Thinker_Run().
+    TICTIME_FRAMEDELTAS,    ///< Sv_GenerateFrameDeltas().
+    TICTIME_MESSAGES,       ///< Handling of received network messages.
+    NUM_TICTIMES
+} tictiming_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void TicTimings_Register(void);
+
+/**
+ * Begins collecting timing statistics. While collecting, the main loop runs one
+ * full tic per iteration without waiting, so the tics are processed as fast as
+ * possible and the real time between tics is the cost of one tic.
+ *
+ * @param maxTics  Number of tics to measure before the results are reported
+ *                 automatically. Zero means no limit; call TicTimings_End().
+ */
+void TicTimings_Begin(int maxTics);
+
+/**
+ * Stops collecting and reports the percentiles of each measurement.
+ */
+void TicTimings_End(void);
+
+dd_bool TicTimings_IsActive(void);
+
+/**
+ * Adds to the time spent on @a part during the current tic. Does nothing unless
+ * statistics are being collected.
+ */
+void TicTimings_Add(tictiming_t part, timespan_t seconds);
+
+/**
+ * Called after each sharp tic to record the samples of the tic.
+ */
+void TicTimings_EndTic(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // DENG_MISC_TICTIMINGS_H
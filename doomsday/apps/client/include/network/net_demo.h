@@ -51,6 +51,13 @@ dd_bool         Demo_BeginPlayback(const char* filename);
 dd_bool         Demo_ReadPacket(void);
 void            Demo_StopPlayback(void);
 
+/**
+ * Begins playback of a demo in timedemo mode. The demo is played back as fast as
+ * possible, and timing statistics are collected for each tic and reported when
+ * the playback stops (see TicTimings_Begin()).
+ */
+dd_bool         Demo_BeginTimeDemo(const char* filename);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
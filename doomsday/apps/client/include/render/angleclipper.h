@@ -23,6 +23,7 @@
 
 #include <de/binangle.h>
 #include <de/Vector>
+#include <QVector>
 #include "Face"
 
 /**
@@ -68,6 +69,41 @@ struct AngleRange
  */
 class AngleClipper
 {
+public:
+    /**
+     * Calls made to a clipper, e.g., during the BSP traversals of a few frames.
+     * Replaying the recording repeats exactly the same clipping work, which is
+     * useful for benchmarking.
+     */
+    struct Recording
+    {
+        enum Op {
+            ClearRanges,
+            SafeAddRange,
+            AddRangeFromViewRelPoints,
+            AddViewRelOcclusion,
+            CheckRangeFromViewRelPoints,
+            IsFull,
+            IsAngleVisible,
+            IsPointVisible,
+            IsPolyVisible
+        };
+
+        struct Call
+        {
+            Op op;
+            binangle_t from;
+            binangle_t to;
+            de::Vector3d fromPoint;
+            de::Vector3d toPoint;
+            coord_t height;
+            bool topHalf;
+            de::Face const *poly;
+        };
+
+        QVector<Call> calls;
+    };
+
 public:
     AngleClipper();
 
@@ -136,9 +172,25 @@ public:  // --------------------------------------------------------------------
      */
     de::dint checkRangeFromViewRelPoints(de::Vector2d const &from, de::Vector2d const &to);
 
+    /**
+     * Starts or stops recording the calls made to the clipper.
+     *
+     * @param recording  Calls are appended here. Use @c nullptr to stop recording.
+     */
+    void setRecording(Recording *recording);
+
+    /**
+     * Repeats the calls of @a recording. The view-relative calls use the current
+     * eye origin, so it must be the same as when the recording was made. The faces
+     * of IsPolyVisible calls must still exist.
+     *
+     * @return  Number of the checks that found something visible.
+     */
+    de::dint replay(Recording const &recording);
+
 #ifdef DENG2_DEBUG
     /**
-     * A debugging aid: checks if clipnode links are valid.
+     * A debugging aid: checks that the clipped ranges are sorted and disjoint.
      */
     void validate();
 #endif
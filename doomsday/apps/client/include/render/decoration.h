@@ -62,6 +62,14 @@ public:
      */
     MaterialAnimator::Decoration const &source() const;
 
+    /**
+     * Change the source of the decoration. Allows reusing decorations when a surface
+     * is decorated again.
+     *
+     * @param newSource  New source of the decoration.
+     */
+    void setSource(MaterialAnimator::Decoration const &newSource);
+
     /**
      * Returns @c true iff a surface is attributed for the decoration.
      *
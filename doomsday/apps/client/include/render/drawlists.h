@@ -30,6 +30,15 @@ class DrawLists
 public:
     typedef QVarLengthArray<DrawList *, 1024> FoundLists;
 
+    /// Lookup statistics, collected only when enabled.
+    struct Statistics
+    {
+        int findCount    = 0;
+        int probeCount   = 0; ///< Lists compared in hash buckets.
+        int createdCount = 0;
+        double findTime  = 0; ///< Seconds.
+    };
+
 public:
     DrawLists();
 
@@ -44,7 +53,8 @@ public:
 
     /**
      * Finds all draw lists which match the given specification. Note that only
-     * non-empty lists are collected.
+     * non-empty lists are collected. The lists are ordered by their textures to
+     * minimize state changes when drawing them in order.
      *
      * @param group  Logical geometry group identifier.
      * @param found  Set of draw lists which match the result.
@@ -63,7 +73,16 @@ public:
      */
     void clear();
 
+    /**
+     * Enables or disables collecting lookup statistics. Enabling resets the statistics.
+     */
+    void setCollectStatistics(bool enabled);
+
+    Statistics const &statistics() const;
+
 private:
+    DrawList &findList(DrawListSpec const &spec);
+
     DENG2_PRIVATE(d)
 };
 
@@ -41,6 +41,7 @@ struct ProjectionList
 
 private:
     static Node *firstNode;
+    static Node *lastNode;
     static Node *cursorNode;
 
     static Node *newNode();
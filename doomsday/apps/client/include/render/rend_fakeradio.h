@@ -83,6 +83,12 @@ void Rend_DrawWallRadio(WallEdge const &leftEdge, WallEdge const &rightEdge, de:
  */
 void Rend_DrawFlatRadio(world::ConvexSubspace const &subspace);
 
+/**
+ * Forgets the shadow parameters cached for walls and flats. These are keyed by map
+ * elements, so this must be called when the current map is unloaded.
+ */
+void Rend_RadioClearCache();
+
 /**
  * Register the console commands, variables, etc..., of this module.
  */
@@ -167,6 +167,50 @@ bool Rend_IsMTexDetails();
 
 void Rend_RenderMap(world::Map &map);
 
+/**
+ * Statistics about the CPU-side preparation of the visible world geometry (the
+ * "front end" of map rendering). Times are in seconds and accumulate over all the
+ * frames prepared since the statistics were last reset. The walls, flats, and
+ * sky mask stages include the time spent in lighting, dynamics, and shadows.
+ */
+struct RendFrontEndStats
+{
+    int frames = 0;
+
+    double decorationTime  = 0; ///< Projecting decoration flares.
+    double traversalTime   = 0; ///< BSP traversal, including the per-subspace stages below.
+    double clippingTime    = 0; ///< Occlusion and angle clipping, lumobj clipping.
+    double spriteTime      = 0; ///< Vissprite projection.
+    double skyMaskTime     = 0;
+    double wallTime        = 0;
+    double flatTime        = 0; ///< Planes, written after the traversal.
+    double lightingTime    = 0; ///< Vertex lighting of walls and flats.
+    double dynamicsTime    = 0; ///< Dynamic light, glow, and shadow projection.
+    double shadowTime      = 0; ///< FakeRadio shadow geometry.
+
+    int subspaceCount      = 0; ///< Subspaces visited.
+    int wallCount          = 0; ///< Wall sections written.
+    int flatCount          = 0; ///< Planes written.
+    int visSpriteCount     = 0;
+    int drawListCount      = 0; ///< Non-empty draw lists.
+    de::duint vertexCount  = 0; ///< Vertices allocated from the geometry store.
+};
+
+/**
+ * Prepares the visible world geometry for the current viewer into the draw lists,
+ * without drawing anything. This is the part of Rend_RenderMap() that does not
+ * need a GL context (apart from preparing the material textures used).
+ */
+void Rend_PrepareMap(world::Map &map);
+
+/**
+ * Enables or disables collecting front end statistics in Rend_PrepareMap().
+ * Enabling resets the statistics.
+ */
+void Rend_SetFrontEndProfiling(bool enabled);
+
+RendFrontEndStats const &Rend_FrontEndStats();
+
 float Rend_FieldOfView();
 
 /**
@@ -28,6 +28,7 @@
 #include <de/Vector>
 #include <de/ModelBank>
 #include <de/ModelDrawable>
+#include <QVector>
 
 class TextureVariantSpec;
 namespace render { class StateAnimator; }
@@ -130,7 +131,18 @@ TextureVariantSpec const &Rend_ModelDiffuseTextureSpec(bool noCompression);
 TextureVariantSpec const &Rend_ModelShinyTextureSpec();
 
 /**
- * Render all the submodels of a model.
+ * Prepares the vertices of all the submodels of the given model vissprites ahead of
+ * drawing them. The parameters of each submodel are determined on the calling thread,
+ * after which the vertices (interpolation, lighting and shiny texture coordinates)
+ * are prepared concurrently. Any previously prepared vertices are discarded.
+ *
+ * @param sprites  Vissprites of type VSPR_MODEL.
+ */
+void Rend_PrepareModels(QVector<vissprite_t const *> const &sprites);
+
+/**
+ * Render all the submodels of a model. If the model was not prepared beforehand
+ * with Rend_PrepareModels(), its vertices are prepared here.
  */
 void Rend_DrawModel(vissprite_t const &spr);
 
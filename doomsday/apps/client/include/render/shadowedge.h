@@ -93,6 +93,12 @@ public:
         return Vector3d(inner() - outer()).abs().length();
     }
 
+    /**
+     * Forgets all previously prepared edges. The cache is keyed by map half-edges, so
+     * it must be cleared when the current map is unloaded.
+     */
+    static void clearCache();
+
 private:
     DENG2_PRIVATE(d)
 };
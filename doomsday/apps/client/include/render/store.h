@@ -41,6 +41,8 @@ struct Store
 
     de::duint allocateVertices(de::duint count);
 
+    de::duint vertexCount() const { return _vertCount; }
+
 private:
     de::duint _vertCount = 0;
     de::duint _vertMax   = 0;
@@ -40,6 +40,7 @@ struct VectorLightList
 
 private:
     static Node *firstNode;
+    static Node *lastNode;
     static Node *cursorNode;
 
     static Node *newNode();
@@ -110,6 +110,12 @@ int R_FrameCount();
 
 void R_ResetFrameCount();
 
+/**
+ * Advances the internal frame count without rendering anything, so that per-frame
+ * state (e.g., projected sprites) is recalculated for the next frame.
+ */
+void R_IncrementFrameCount();
+
 /**
  * Render all view ports in the viewport grid.
  */
@@ -123,6 +123,12 @@ public:
 
     Event const &at(EventIndex index) const;
 
+    /**
+     * Forgets all the cached edge divisions and normals. The cache is keyed by map
+     * half-edges, so it must be cleared when the current map is unloaded.
+     */
+    static void clearCache();
+
 private:
     struct Impl;
     Impl *d;
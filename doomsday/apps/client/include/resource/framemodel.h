@@ -64,16 +64,17 @@ public:
 
     /**
      * Animation key-frame.
+     *
+     * Vertex positions and normals are stored in separate, contiguous arrays so
+     * that interpolating between frames can be done with tight loops over plain
+     * floats.
      */
     struct Frame
     {
         FrameModel &model;
-        struct Vertex {
-            de::Vector3f pos;
-            de::Vector3f norm;
-        };
-        typedef QVector<Vertex> VertexBuf;
-        VertexBuf vertices;
+        typedef QVector<de::Vector3f> Coords;
+        Coords positions; ///< Indexed by vertex number.
+        Coords normals;   ///< Indexed by vertex number.
         de::Vector3f min;
         de::Vector3f max;
         de::String name;
@@ -71,12 +71,85 @@ public:
         int sound; ///< Queued sound ID.
         float volume; ///< Volume for queued sound.
 
+        /**
+         * Movement received from the server, timestamped with the server's game time.
+         * Remote objects are drawn by interpolating between the snapshots a short
+         * playout delay behind the most recent one.
+         */
+        struct Snapshot
+        {
+            float time;         ///< Server game time (seconds).
+            coord_t origin[3];
+            coord_t mom[3];
+            angle_t angle;
+        };
+        enum { SNAPSHOT_COUNT = 8 };
+        Snapshot snapshots[SNAPSHOT_COUNT]; ///< Ring buffer.
+        int snapshotCount;      ///< Number of valid snapshots.
+        int latestSnapshot;     ///< Ring index of the most recent snapshot.
+        coord_t correction[3];  ///< Error left over from extrapolation, blended out.
+        float correctionTime;   ///< When the correction was last set.
+        float shownTime;        ///< Time at which the object was most recently drawn.
+        bool shown;             ///< @c true, if shownTime is valid.
+
         RemoteSync()
             : flags(0)
             , time(Timer_RealMilliseconds())
             , sound(0)
             , volume(0)
-        {}
+            , snapshotCount(0)
+            , latestSnapshot(0)
+            , correctionTime(0)
+            , shownTime(0)
+            , shown(false)
+        {
+            correction[0] = correction[1] = correction[2] = 0;
+        }
+
+        /**
+         * Adds a new snapshot of the object's movement. Snapshots must be added in
+         * chronological order. If the object moves too far for interpolation to make
+         * sense (e.g., teleports), the older snapshots are discarded.
+         */
+        void addSnapshot(float time, coord_t const origin[3], coord_t const mom[3],
+                         angle_t angle);
+
+        void clearSnapshots();
+
+        /**
+         * Determines the object's origin at a point in time. Between two snapshots
+         * the origin is interpolated; past the latest snapshot it is extrapolated
+         * using momentum for a short while.
+         *
+         * @param time    Server game time.
+         * @param origin  The origin is written here.
+         *
+         * @return @c true, if there were snapshots to evaluate.
+         */
+        bool evaluate(float time, coord_t origin[3]) const;
+
+        /**
+         * Determines the object's angle at a point in time.
+         *
+         * @param time   Server game time.
+         * @param angle  The angle is written here.
+         *
+         * @return @c true, if there were snapshots to evaluate.
+         */
+        bool evaluateAngle(float time, angle_t *angle) const;
+
+        /**
+         * Determines whether the snapshots are too old to be used at @a time, meaning
+         * the server is no longer sending movement for the object.
+         */
+        bool isStale(float time) const;
+
+        /**
+         * Remembers that the object was drawn at the origin evaluated for @a time.
+         * If a new snapshot shows that the origin was extrapolated incorrectly, the
+         * error is blended out.
+         */
+        void markShown(float time);
     };
 
 public:
@@ -482,6 +482,12 @@ public:
          */
         edgespan_t const &radioEdgeSpan(bool top) const;
 
+        /**
+         * Returns a counter that is incremented whenever the FakeRadio data of the side
+         * is recalculated in updateRadioForFrame(). Used for validating cached shadows.
+         */
+        de::duint radioVersion() const;
+
 #endif  // __CLIENT__
 
     //- Line Accessors (side relative) --------------------------------------------------
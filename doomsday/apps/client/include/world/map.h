@@ -846,6 +846,13 @@ public:  /// @todo Most of the following should be private:
      */
     void initRadio();
 
+    /**
+     * Calculate the environmental audio (reverb) characteristics of all subsectors.
+     * The work is split over the task pool: subspace audio environments are updated
+     * first, followed by the subsectors that combine them.
+     */
+    void initReverb();
+
     /**
      * Spawn all generators for the map which should be initialized automatically during
      * map setup.
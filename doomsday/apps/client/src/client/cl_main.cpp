@@ -23,6 +23,7 @@
 #include "api_client.h"
 #include "client/cl_frame.h"
 #include "client/cl_infine.h"
+#include "client/cl_mobj.h"
 #include "client/cl_player.h"
 #include "client/cl_sound.h"
 #include "client/cl_world.h"
@@ -476,6 +477,8 @@ void Cl_Ticker(timespan_t ticLength)
 #endif
     }
 
+    ClMobj_AdvancePlayout(ticLength);
+
     if (App_World().hasMap())
     {
         App_World().map().expireClMobjs();
@@ -26,11 +26,14 @@
 
 #include "api_client.h"
 #include "client/cl_player.h"
+#include "client/cl_frame.h"
 #include "client/cl_world.h"
 
 #include "network/net_main.h"
 #include "network/protocol.h"
 
+#include "dd_loop.h"
+
 #include "world/map.h"
 #include "world/p_players.h"
 
@@ -48,6 +51,10 @@ using namespace world;
 #define UNFIXED8_8(x)   (((x) << 16) / 256)
 #define UNFIXED10_6(x)  (((x) << 16) / 64)
 
+float clMobjPlayoutDelay = .1f;
+
+static float playoutClock; ///< Estimate of the server's current game time.
+
 #if 0
 ClMobjInfo::ClMobjInfo()
     : startMagic(CLM_MAGIC1)
@@ -564,6 +571,13 @@ void ClMobj_ReadDelta()
             }
         }
 
+        // Remember the movement for drawing the mobj smoothly.
+        if (!d->dPlayer && (df & (MDF_ORIGIN_X | MDF_ORIGIN_Y | MDF_ORIGIN_Z | MDF_ANGLE |
+                                  MDF_MOM_X | MDF_MOM_Y | MDF_MOM_Z)))
+        {
+            info->addSnapshot(Cl_FrameGameTime(), d->origin, d->mom, d->angle);
+        }
+
         // Update players.
         if (d->dPlayer)
         {
@@ -577,6 +591,77 @@ void ClMobj_ReadDelta()
     }
 }
 
+void ClMobj_AdvancePlayout(timespan_t ticLength)
+{
+    playoutClock += ticLength;
+
+    // Follow the server's clock. Small differences are steered away gradually so that
+    // movement remains smooth; large ones mean we are out of sync (e.g., map change).
+    float const drift = Cl_FrameGameTime() - playoutClock;
+    if (std::fabs(drift) > .5f)
+    {
+        playoutClock = Cl_FrameGameTime();
+    }
+    else
+    {
+        playoutClock += drift * .1f;
+    }
+}
+
+static float playoutTime()
+{
+    return playoutClock + frameTimePos / TICSPERSEC - clMobjPlayoutDelay;
+}
+
+/**
+ * Returns the snapshot state of a remote mobj, if it should be drawn using it.
+ */
+static ClientMobjThinkerData::RemoteSync *playoutInfo(mobj_t *mob)
+{
+    if (!isClient || !mob || mob->dPlayer || clMobjPlayoutDelay <= 0) return nullptr;
+
+    // The server stops sending the origin of missiles after they are launched; the
+    // client moves them itself.
+    if (mob->ddFlags & DDMF_MISSILE) return nullptr;
+
+    ClientMobjThinkerData::RemoteSync *info = ClMobj_GetInfo(mob);
+    if (!info || (info->flags & CLMF_LOCAL_ACTIONS))
+    {
+        return nullptr;
+    }
+
+    // Without recent snapshots the mobj is not being moved by the server (anymore),
+    // so its current origin is the one to draw.
+    if (info->isStale(playoutTime()))
+    {
+        return nullptr;
+    }
+    return info;
+}
+
+bool ClMobj_OriginSmoothed(mobj_t *mob, coord_t origin[3])
+{
+    ClientMobjThinkerData::RemoteSync *info = playoutInfo(mob);
+    if (!info) return false;
+
+    float const time = playoutTime();
+    if (!info->evaluate(time, origin)) return false;
+    info->markShown(time);
+
+    if (info->flags & (CLMF_STICK_FLOOR | CLMF_STICK_CEILING))
+    {
+        // Plane movement is applied locally.
+        origin[VZ] = mob->origin[VZ];
+    }
+    return true;
+}
+
+bool ClMobj_AngleSmoothed(mobj_t *mob, angle_t *angle)
+{
+    ClientMobjThinkerData::RemoteSync const *info = playoutInfo(mob);
+    return info && info->evaluateAngle(playoutTime(), angle);
+}
+
 void ClMobj_ReadNullDelta()
 {
     LOG_AS("ClMobj_ReadNullDelta");
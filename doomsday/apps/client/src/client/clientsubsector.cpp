@@ -26,6 +26,7 @@
 #include "world/p_object.h"
 #include "world/p_players.h"
 #include "world/surface.h"
+#include "world/lineowner.h"
 #include "client/clskyplane.h"
 #include "client/cledgeloop.h"
 
@@ -41,6 +42,7 @@
 #include "dd_main.h"  // verbose
 
 #include <de/LogBuffer>
+#include <de/TaskPool>
 
 #include <QtAlgorithms>
 #include <QHash>
@@ -94,6 +96,29 @@ static DotPath composeSurfacePath(Surface const &surface)
 }
 #endif // DENG2_DEBUG
 
+/**
+ * Decoration pattern of a material on a surface, queued for plotting.
+ */
+struct DecorationPattern
+{
+    ClientSubsector *subsector;  ///< Plotted decorations must lie in this subsector.
+    Surface *surface;
+    MaterialAnimator::Decoration const *source;
+    Vector3d origin;             ///< Top left corner, at the decoration's elevation.
+    Vector3d delta;              ///< Top left to bottom right corner of the surface.
+    Vector2d dimensions;         ///< Of the surface.
+    Vector2f start;              ///< First offset of the pattern on the surface.
+    Vector2f repeat;             ///< Pattern step size.
+    dint axis;                   ///< Major axis of the surface normal.
+    QVector<Vector3d> points;    ///< Plotted decoration origins.
+};
+
+/// Patterns waiting for ClientSubsector::plotQueuedDecorations().
+static QVector<DecorationPattern> decorationQueue;
+
+/// Number of patterns per task when plotting concurrently.
+static dint const DECORATION_BATCH_SIZE = 8;
+
 /**
  * @todo optimize: Translation of decorations on the world up axis would be a trivial
  * operation to perform, which, would not require plotting decorations again. This
@@ -175,12 +200,15 @@ DENG2_PIMPL(ClientSubsector)
     struct DecoratedSurface : public Surface::IDecorationState
     {
         QVector<Decoration *> decorations;
+        QVector<LightDecoration *> unused;  ///< Cleared decorations, for reuse.
         bool needUpdate = true;
+        bool queued     = false;  ///< Patterns waiting in the decoration queue.
 
         DecoratedSurface() {}
 
         ~DecoratedSurface() {
             qDeleteAll(decorations);
+            qDeleteAll(unused);
         }
 
         void markForUpdate(bool yes = true) {
@@ -191,9 +219,26 @@ DENG2_PIMPL(ClientSubsector)
         void clear()
         {
             markForUpdate(false);
-            qDeleteAll(decorations);
+            for (Decoration *decor : decorations)
+            {
+                // Only light decorations are created for surfaces.
+                unused.append(static_cast<LightDecoration *>(decor));
+            }
             decorations.clear();
         }
+
+        LightDecoration *newDecoration(MaterialAnimator::Decoration const &source,
+                                       Vector3d const &origin)
+        {
+            if (unused.isEmpty())
+            {
+                return new LightDecoration(source, origin);
+            }
+            LightDecoration *decor = unused.takeLast();
+            decor->setSource(source);
+            decor->setOrigin(origin);
+            return decor;
+        }
     };
 
     dint validFrame;
@@ -226,6 +271,9 @@ DENG2_PIMPL(ClientSubsector)
     AudioEnvironment reverb;
     bool needReverbUpdate = true;
 
+    /// Incremented when the wall geometry around the subsector changes.
+    duint geometryVersion = 0;
+
     // Per surface lists of light decoration info and state.
     QSet<Surface *> decorSurfaces;
 
@@ -809,6 +857,9 @@ DENG2_PIMPL(ClientSubsector)
      * that is), they do not move and are not created/destroyed once the map has
      * been loaded; this step can be pre-processed.
      *
+     * Does not use the global validCount, so that subsectors can be processed
+     * concurrently (the set takes care of duplicates).
+     *
      * @pre The Map's BSP leaf blockmap must be ready for use.
      */
     void findReverbSubspaces()
@@ -823,23 +874,18 @@ DENG2_PIMPL(ClientSubsector)
 
         // Link all convex subspaces whose axis-aligned bounding box intersects
         // with the affection bounds to the reverb set.
-        dint const localValidCount = ++validCount;
-        map.subspaceBlockmap().forAllInBox(box, [this, &box, &localValidCount] (void *object)
+        map.subspaceBlockmap().forAllInBox(box, [this, &box] (void *object)
         {
             auto &sub = *(ConvexSubspace *)object;
-            if (sub.validCount() != localValidCount) // not yet processed
+
+            // Check the bounds.
+            AABoxd const &polyBounds = sub.poly().bounds();
+            if (!(   polyBounds.maxX < box.minX
+                  || polyBounds.minX > box.maxX
+                  || polyBounds.minY > box.maxY
+                  || polyBounds.maxY < box.minY))
             {
-                sub.setValidCount(localValidCount);
-
-                // Check the bounds.
-                AABoxd const &polyBounds = sub.poly().bounds();
-                if (!(   polyBounds.maxX < box.minX
-                      || polyBounds.minX > box.maxX
-                      || polyBounds.minY > box.maxY
-                      || polyBounds.maxY < box.minY))
-                {
-                    addReverbSubspace(&sub);
-                }
+                addReverbSubspace(&sub);
             }
             return LoopContinue;
         });
@@ -847,8 +893,11 @@ DENG2_PIMPL(ClientSubsector)
 
     /**
      * Recalculate environmental audio (reverb) for the sector.
+     *
+     * @param updateSubspaces  @c true= update the audio environments of the reverb
+     *                         subspaces first. Otherwise they are assumed current.
      */
-    void updateReverb()
+    void updateReverb(bool updateSubspaces = true)
     {
         // Need to initialize?
         if (reverbSubspaces.isEmpty())
@@ -865,16 +914,19 @@ DENG2_PIMPL(ClientSubsector)
 
         for (ConvexSubspace *subspace : reverbSubspaces)
         {
-            if (subspace->updateAudioEnvironment())
+            if (updateSubspaces)
             {
-                auto const &aenv = subspace->audioEnvironment();
+                subspace->updateAudioEnvironment();
+            }
 
-                reverb.space   += aenv.space;
+            // Subspaces without an environment have been reset and add nothing.
+            auto const &aenv = subspace->audioEnvironment();
 
-                reverb.volume  += aenv.volume  / 255.0f * aenv.space;
-                reverb.decay   += aenv.decay   / 255.0f * aenv.space;
-                reverb.damping += aenv.damping / 255.0f * aenv.space;
-            }
+            reverb.space   += aenv.space;
+
+            reverb.volume  += aenv.volume  / 255.0f * aenv.space;
+            reverb.decay   += aenv.decay   / 255.0f * aenv.space;
+            reverb.damping += aenv.damping / 255.0f * aenv.space;
         }
 
         dfloat spaceScatter;
@@ -1010,12 +1062,13 @@ DENG2_PIMPL(ClientSubsector)
         if (sufDimensions.x < 0) sufDimensions.x = -sufDimensions.x;
         if (sufDimensions.y < 0) sufDimensions.y = -sufDimensions.y;
 
-        // Generate a number of decorations.
+        auto &ds = *static_cast<DecoratedSurface *>(suf.decorationState());
+
+        // Queue the decoration patterns for plotting.
         dint decorIndex = 0;
 
-        material.forAllDecorations([this, &suf, &matAnimator, &materialOrigin
-                                   , &topLeft, &bottomRight
-                                   , &delta, &axis, &sufDimensions, &decorIndex]
+        material.forAllDecorations([this, &suf, &ds, &matAnimator, &materialOrigin
+                                   , &topLeft, &delta, &axis, &sufDimensions, &decorIndex]
                                    (MaterialDecoration &decor)
         {
             Vector2ui const &matDimensions = matAnimator.material().dimensions();
@@ -1029,38 +1082,21 @@ DENG2_PIMPL(ClientSubsector)
             if (repeat == Vector2f(0, 0))
                 return LoopAbort;
 
-            Vector3d origin = topLeft + suf.normal() * decorSS.elevation();
-
-            dfloat s = de::wrap(decorSS.origin().x - matDimensions.x * decor.patternOffset().x + materialOrigin.x,
-                                0.f, repeat.x);
-
-            // Plot decorations.
-            for (; s < sufDimensions.x; s += repeat.x)
-            {
-                // Determine the topmost point for this row.
-                dfloat t = de::wrap(decorSS.origin().y - matDimensions.y * decor.patternOffset().y + materialOrigin.y,
-                                    0.f, repeat.y);
-
-                for (; t < sufDimensions.y; t += repeat.y)
-                {
-                    auto const offset = Vector2f(s, t) / sufDimensions;
-                    Vector3d patternOffset(offset.x,
-                                           axis == 2 ? offset.y : offset.x,
-                                           axis == 2 ? offset.x : offset.y);
-
-                    Vector3d decorOrigin = origin + delta * patternOffset;
-                    // The point must be in the correct subsector.
-                    if (suf.map().subsectorAt(decorOrigin) == thisPublic)
-                    {
-                        std::unique_ptr<LightDecoration> decor(new LightDecoration(decorSS, decorOrigin));
-                        decor->setSurface(&suf);
-                        if (self().sector().hasMap()) decor->setMap(&self().sector().map());
-                        static_cast<DecoratedSurface *>(suf.decorationState())->
-                                decorations.append(decor.get()); // take ownership.
-                        decor.release();
-                    }
-                }
-            }
+            DecorationPattern pattern;
+            pattern.subsector  = thisPublic;
+            pattern.surface    = &suf;
+            pattern.source     = &decorSS;
+            pattern.origin     = topLeft + suf.normal() * decorSS.elevation();
+            pattern.delta      = delta;
+            pattern.dimensions = sufDimensions;
+            pattern.repeat     = repeat;
+            pattern.axis       = axis;
+            pattern.start      = Vector2f(de::wrap(decorSS.origin().x - matDimensions.x * decor.patternOffset().x + materialOrigin.x,
+                                                   0.f, repeat.x),
+                                          de::wrap(decorSS.origin().y - matDimensions.y * decor.patternOffset().y + materialOrigin.y,
+                                                   0.f, repeat.y));
+            decorationQueue.append(pattern);
+            ds.queued = true;
 
             decorIndex += 1;
             return LoopContinue;
@@ -1093,7 +1129,7 @@ DENG2_PIMPL(ClientSubsector)
         // Has a decorated material, so needs decoration state.
         auto &ds = allocDecorationState(surface);
 
-        if (!ds.needUpdate) return;
+        if (!ds.needUpdate || ds.queued) return;
 
         LOGDEV_MAP_XVERBOSE_DEBUGONLY("  decorating %s%s"
             , composeSurfacePath(surface)
@@ -1218,6 +1254,7 @@ DENG2_PIMPL(ClientSubsector)
     void lineFlagsChanged(Line &line, dint oldFlags) override
     {
         LOG_AS("ClientSubsector");
+        geometryVersion++;
         line.forAllSides([this, &oldFlags] (LineSide &side)
         {
             if (side.sectorPtr() == &self().sector())
@@ -1244,6 +1281,7 @@ DENG2_PIMPL(ClientSubsector)
     void materialDimensionsChanged(Material &material) override
     {
         LOG_AS("ClientSubsector");
+        geometryVersion++;
         markDependentSurfacesForRedecoration(material);
     }
 
@@ -1266,6 +1304,7 @@ DENG2_PIMPL(ClientSubsector)
     void planeHeightChanged(Plane &plane) override
     {
         LOG_AS("ClientSubsector");
+        geometryVersion++;
 
         // We may need to update one or both mapped planes.
 //        maybeInvalidateMapping(plane.indexInSector());
@@ -1340,6 +1379,7 @@ DENG2_PIMPL(ClientSubsector)
     void planeHeightSmoothedChanged(Plane &plane) override
     {
         LOG_AS("ClientSubsector");
+        geometryVersion++;
 
         // We may need to update one or both mapped planes.
 //        maybeInvalidateMapping(plane.indexInSector());
@@ -1377,6 +1417,7 @@ DENG2_PIMPL(ClientSubsector)
     void surfaceMaterialChanged(Surface &surface) override
     {
         LOG_AS("ClientSubsector");
+        geometryVersion++;
 
         if (auto *ds = static_cast<DecoratedSurface *>(surface.decorationState()))
         {
@@ -1716,11 +1757,47 @@ bool ClientSubsector::hasWorldVolume(bool useSmoothedHeights) const
     return d->hasWorldVolumeInValidFrame;
 }
 
+duint ClientSubsector::geometryVersion() const
+{
+    return d->geometryVersion;
+}
+
+duint ClientSubsector::sectorGeometryVersion(Sector const *sector) // static
+{
+    duint version = 0;
+    if (sector)
+    {
+        for (dint i = 0; i < sector->subsectorCount(); ++i)
+        {
+            version += sector->subsector(i).as<ClientSubsector>().geometryVersion();
+        }
+    }
+    return version;
+}
+
+duint ClientSubsector::vertexGeometryVersion(LineOwner const &base) // static
+{
+    duint version = 0;
+    LineOwner const *own = &base;
+    do
+    {
+        Line const &line = own->line();
+        version += sectorGeometryVersion(line.front().sectorPtr());
+        version += sectorGeometryVersion(line.back ().sectorPtr());
+    } while ((own = own->next()) != &base);
+    return version;
+}
+
 void ClientSubsector::markReverbDirty(bool yes)
 {
     d->needReverbUpdate = yes;
 }
 
+void ClientSubsector::updateReverbFromSubspaces()
+{
+    d->updateReverb(false /*subspaces are current*/);
+}
+
 ClientSubsector::AudioEnvironment const &ClientSubsector::reverb() const
 {
     // Perform any scheduled update now.
@@ -1974,6 +2051,56 @@ void ClientSubsector::decorate()
     d->decorate(visCeiling().surface());
 }
 
+void ClientSubsector::plotQueuedDecorations() // static
+{
+    if (decorationQueue.isEmpty()) return;
+
+    // Plot the patterns concurrently. This only reads the map.
+    DecorationPattern *patterns = decorationQueue.data();
+    TaskPool::parallelFor(decorationQueue.size(), [patterns] (int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            DecorationPattern &pattern = patterns[i];
+            Map const &map = pattern.surface->map();
+
+            pattern.points.clear();
+            for (dfloat s = pattern.start.x; s < pattern.dimensions.x; s += pattern.repeat.x)
+            for (dfloat t = pattern.start.y; t < pattern.dimensions.y; t += pattern.repeat.y)
+            {
+                auto const offset = Vector2f(s, t) / pattern.dimensions;
+                Vector3d patternOffset(offset.x,
+                                       pattern.axis == 2 ? offset.y : offset.x,
+                                       pattern.axis == 2 ? offset.x : offset.y);
+
+                Vector3d decorOrigin = pattern.origin + pattern.delta * patternOffset;
+                // The point must be in the correct subsector.
+                if (map.subsectorAt(decorOrigin) == pattern.subsector)
+                {
+                    pattern.points.append(decorOrigin);
+                }
+            }
+        }
+    }, DECORATION_BATCH_SIZE);
+
+    // Create the decorations in queue order.
+    for (DecorationPattern const &pattern : decorationQueue)
+    {
+        auto &ds = *static_cast<Impl::DecoratedSurface *>(pattern.surface->decorationState());
+        Map *map = pattern.subsector->sector().hasMap() ? &pattern.subsector->sector().map() : nullptr;
+
+        for (Vector3d const &point : pattern.points)
+        {
+            LightDecoration *decor = ds.newDecoration(*pattern.source, point);
+            decor->setSurface(pattern.surface);
+            if (map) decor->setMap(map);
+            ds.decorations.append(decor);
+        }
+        ds.queued = false;
+    }
+    decorationQueue.clear();
+}
+
 bool ClientSubsector::hasDecorations() const
 {
     return !d.getConst()->decorSurfaces.isEmpty();
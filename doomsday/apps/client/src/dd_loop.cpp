@@ -30,6 +30,7 @@
 #include <doomsday/console/exec.h>
 #include <doomsday/console/var.h>
 
+#include "misc/tictimings.h"
 #include "network/net_event.h"
 #include "sys_system.h"
 #include "world/p_ticker.h"
@@ -142,6 +143,12 @@ static void checkSharpTick(timespan_t time)
         // calculated, so that @var frameTime always stays within the range 0..1.
         ::realFrameTimePos += time * TICSPERSEC;
 
+        // While timing tics, every tick is a full tic.
+        if(TicTimings_IsActive())
+        {
+            ::realFrameTimePos = de::max(::realFrameTimePos, 1.f);
+        }
+
         // When one full tick has passed, it is time to do a sharp tick.
         if(::realFrameTimePos >= 1)
         {
@@ -197,6 +204,8 @@ static void baseTicker(timespan_t time)
             // Set frametime back by one tick (to stay in the 0..1 range).
             ::realFrameTimePos -= 1;
 
+            TicTimings_EndTic();
+
 #ifdef __CLIENT__
             // Camera smoothing: now that the world tic has occurred, the next sharp
             // position can be processed.
@@ -330,6 +339,7 @@ void DD_WaitForOptimalUpdateTime()
     duint const optimalDelta = duint(::maxFrameRate > 0? 1000/::maxFrameRate : 1);
 
     if (Sys_IsShuttingDown()) return; // No need for finesse.
+    if (TicTimings_IsActive()) return; // Tics are being timed as fast as possible.
 
     // This is when we would ideally like to make the update.
     duint const targetUpdateTime = prevUpdateTime + optimalDelta;
@@ -403,6 +413,12 @@ void Loop_RunTics()
     // Remember when this frame started.
     ::lastRunTicsTime = nowTime;
 
+    if(TicTimings_IsActive())
+    {
+        // Run exactly one tic per frame, regardless of how much real time passed.
+        elapsedTime = MAX_FRAME_TIME;
+    }
+
     // Tic until all the elapsed time has been processed.
     while(elapsedTime > 0)
     {
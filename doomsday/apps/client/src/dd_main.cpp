@@ -90,6 +90,7 @@
 #include "busyrunner.h"
 #include "con_config.h"
 #include "sys_system.h"
+#include "misc/tictimings.h"
 //#include "ui/editors/edit_bias.h"
 #include "gl/svg.h"
 
@@ -1454,10 +1455,18 @@ void DD_CheckTimeDemo()
     if (!checked)
     {
         checked = true;
-        if (CommandLine_CheckWith("-timedemo", 1) || // Timedemo mode.
-            CommandLine_CheckWith("-playdemo", 1))   // Play-once mode.
+        char const *command = nullptr;
+        if (CommandLine_CheckWith("-timedemo", 1)) // Timedemo mode.
         {
-            Block cmd = String("playdemo %1").arg(CommandLine_Next()).toUtf8();
+            command = "timedemo";
+        }
+        else if (CommandLine_CheckWith("-playdemo", 1)) // Play-once mode.
+        {
+            command = "playdemo";
+        }
+        if (command)
+        {
+            Block cmd = String("%1 %2").arg(command).arg(CommandLine_Next()).toUtf8();
             Con_Execute(CMDS_CMDLINE, cmd.constData(), false, false);
         }
     }
@@ -2469,6 +2478,7 @@ void DD_ConsoleRegister()
 #endif
 
     DD_RegisterLoop();
+    TicTimings_Register();
     Def_ConsoleRegister();
     FS1::consoleRegister();
     Con_Register();
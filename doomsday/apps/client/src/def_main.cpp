@@ -1537,6 +1537,9 @@ void Def_Read()
         }
     }
 
+    // Compile the values needed during gameplay into flat tables.
+    defs.freeze();
+
     // Log a summary of the definition database.
     LOG_RES_MSG(_E(b) "Definitions:");
     String str;
@@ -0,0 +1,138 @@
+/** @file tictimings.cpp  Per-tic timing statistics for benchmarking.
+ *
+ * @authors Copyright © 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de_base.h"
+#include "misc/tictimings.h"
+
+#include <doomsday/console/cmd.h>
+#include <de/timer.h>
+#include <QVector>
+#include <algorithm>
+
+using namespace de;
+
+static struct TicTimings
+{
+    bool active = false;
+    int maxTics = 0;
+    ddouble lastTicAt = 0;
+    ddouble parts[NUM_TICTIMES];          ///< Accumulated during the current tic.
+    QVector<dfloat> ticTimes;             ///< Real time per tic (milliseconds).
+    QVector<dfloat> partTimes[NUM_TICTIMES];
+
+    static String percentiles(QVector<dfloat> values)
+    {
+        if (values.isEmpty()) return "(no samples)";
+        std::sort(values.begin(), values.end());
+        auto const at = [&values] (dfloat pct) {
+            return values.at(de::min(values.size() - 1, int(values.size() * pct)));
+        };
+        return String("p50:%1 p90:%2 p99:%3 max:%4 ms")
+                .arg(at(.5f), 0, 'f', 3)
+                .arg(at(.9f), 0, 'f', 3)
+                .arg(at(.99f), 0, 'f', 3)
+                .arg(values.last(), 0, 'f', 3);
+    }
+} timings;
+
+void TicTimings_Begin(int maxTics)
+{
+    timings.active    = true;
+    timings.maxTics   = maxTics;
+    timings.lastTicAt = Timer_Seconds();
+    timings.ticTimes.clear();
+    for (int i = 0; i < NUM_TICTIMES; ++i)
+    {
+        timings.parts[i] = 0;
+        timings.partTimes[i].clear();
+    }
+}
+
+void TicTimings_End()
+{
+    if (!timings.active) return;
+    timings.active = false;
+
+    LOG_MSG("Timings for %i tics:\n"
+            "  Tic: %s\n"
+            "  Thinkers: %s\n"
+            "  Frame deltas: %s\n"
+            "  Message handling: %s")
+            << timings.ticTimes.size()
+            << TicTimings::percentiles(timings.ticTimes)
+            << TicTimings::percentiles(timings.partTimes[TICTIME_THINKERS])
+            << TicTimings::percentiles(timings.partTimes[TICTIME_FRAMEDELTAS])
+            << TicTimings::percentiles(timings.partTimes[TICTIME_MESSAGES]);
+}
+
+dd_bool TicTimings_IsActive()
+{
+    return timings.active;
+}
+
+void TicTimings_Add(tictiming_t part, timespan_t seconds)
+{
+    if (timings.active)
+    {
+        timings.parts[part] += seconds;
+    }
+}
+
+void TicTimings_EndTic()
+{
+    if (!timings.active) return;
+
+    ddouble const now = Timer_Seconds();
+    timings.ticTimes << dfloat((now - timings.lastTicAt) * 1000);
+    timings.lastTicAt = now;
+    for (int i = 0; i < NUM_TICTIMES; ++i)
+    {
+        timings.partTimes[i] << dfloat(timings.parts[i] * 1000);
+        timings.parts[i] = 0;
+    }
+
+    if (timings.maxTics > 0 && timings.ticTimes.size() >= timings.maxTics)
+    {
+        TicTimings_End();
+    }
+}
+
+D_CMD(TimeTics)
+{
+    DENG2_UNUSED(src);
+
+    if (argc != 2)
+    {
+        LOG_SCR_NOTE("Usage: %s (numtics)") << argv[0];
+        LOG_SCR_MSG("Runs the given number of tics as fast as possible and reports "
+                    "how long they took.");
+        return true;
+    }
+
+    int const count = String(argv[1]).toInt();
+    if (count <= 0) return false;
+
+    LOG_MSG("Timing %i tics...") << count;
+    TicTimings_Begin(count);
+    return true;
+}
+
+void TicTimings_Register()
+{
+    C_CMD("timetics", nullptr, TimeTics);
+}
@@ -34,11 +34,13 @@
 #include "dd_def.h"
 #include "dd_loop.h"
 #include "dd_main.h"
+#include "misc/tictimings.h"
 
 #include "api_console.h"
 
 #ifdef __CLIENT__
 #  include "client/cl_def.h"
+#  include "client/cl_mobj.h"
 #endif
 #ifdef __SERVER__
 #  include "serversystem.h"
@@ -399,7 +401,9 @@ void Net_Update()
 
     // Check for received packets.
 #ifdef __CLIENT__
+    timespan_t const startedAt = Timer_Seconds();
     Cl_GetPackets();
+    TicTimings_Add(TICTIME_MESSAGES, Timer_Seconds() - startedAt);
 #endif
 }
 
@@ -1313,6 +1317,9 @@ void Net_Register()
     //C_VAR_INT       ("net-master-port",         &::masterPort, 0, 0, 65535);
     //C_VAR_CHARPTR   ("net-master-path",         &::masterPath, 0, 0, 0);
     C_VAR_CHARPTR   ("net-name",                &::playerName, 0, 0, 0);
+#ifdef __CLIENT__
+    C_VAR_FLOAT     ("net-mobj-delay",          &::clMobjPlayoutDelay, 0, 0, 1);
+#endif
 
 #ifdef __SERVER__
     C_VAR_CHARPTR   ("server-name",             &::serverName, 0, 0, 0);
@@ -40,6 +40,16 @@
 #include "world/p_object.h"
 #include "world/p_players.h"
 
+#include "client/cl_def.h"
+#include "misc/tictimings.h"
+#include "sys_system.h"
+
+#include <de/ByteRefArray>
+#include <de/FileSystem>
+#include <de/NativePath>
+#include <de/Reader>
+#include <de/Writer>
+
 using namespace de;
 
 #define DEMOTIC SECONDS_TO_TICKS(demoTime)
@@ -49,20 +59,25 @@ using namespace de;
 #define LCAMF_FOV           0x2  ///< FOV has changed (short).
 #define LCAMF_CAMERA        0x4  ///< Camera mode.
 
-#pragma pack(1)
-struct demopacket_header_t
-{
-    dushort length;
-};
-#pragma pack()
+/*
+ * Demo file format:
+ *
+ * - Header: magic identifier (4 bytes) followed by the format version (duint32).
+ * - Packets until the end of the file, each consisting of:
+ *   - duint32 time: tics since the beginning of the recording
+ *   - duint8 message type
+ *   - duint32 length of the message data
+ *   - message data
+ *
+ * The file is written and read incrementally, one packet at a time.
+ */
+static char const DEMO_MAGIC[4] = { 'D', 'D', 'E', 'M' };
+static duint32 const DEMO_FORMAT_VERSION = 1;
 
 extern dfloat netConnectTime;
 
-static char const *demoPath = "/home/demo/";
+static String const demoPath = "/home/demo";
 
-#if 0
-LZFILE *playdemo;
-#endif
 dint playback;
 dint viewangleDelta;
 dfloat lookdirDelta;
@@ -70,76 +85,86 @@ dfloat posDelta[3];
 dfloat demoFrameZ, demoZ;
 dd_bool demoOnGround;
 
-static DemoTimer readInfo;
-static dfloat startFOV;
-static dint demoStartTic;
+/// Output stream of a player's recording.
+struct DemoRecorder
+{
+    ByteArrayFile *file = nullptr;
+    IByteArray::Offset offset = 0;
+};
+static DemoRecorder recorders[DDMAXPLAYERS];
+
+/// Input stream of the demo being played back.
+static struct DemoPlayer
+{
+    ByteArrayFile const *file = nullptr;
+    IByteArray::Offset offset = 0;
+    duint32 tic = 0;             ///< Playback time (tics).
+    duint32 nextPacketTime = 0;  ///< Time of the packet at @var offset.
+} playDemo;
 
 void Demo_WriteLocalCamera(dint plrNum);
 
 void Demo_Init()
 {
     // Make sure the demo path is there.
-    //F_MakePath(demoPath);
+    FS::get().makeFolder(demoPath);
+}
+
+static String composeDemoPath(char const *fileName)
+{
+    String const name = NativePath(fileName).withSeparators('/');
+    if (name.startsWith("/")) return name;
+    return demoPath / name;
 }
 
 /**
  * Open a demo file and begin recording.
  * Returns @c false if the recording can't be begun.
  */
-dd_bool Demo_BeginRecording(char const * /*fileName*/, dint /*plrNum*/)
+dd_bool Demo_BeginRecording(char const *fileName, dint plrNum)
 {
-    return false;
+    DENG2_ASSERT(plrNum >= 0 && plrNum < DDMAXPLAYERS);
+    auto &cl = *DD_Player(plrNum);
 
-#if 0
-    client_t *cl  = &::clients[plrNum];
-    player_t *plr = &DD_Player(plrNum);
-
-    // Is a demo already being recorded for this client?
-    if(cl->recording || ::playback || (::isDedicated && !plrNum) || !plr->shared.inGame)
+    // Is a demo already being recorded for this client? Only the packets
+    // received from a server can be recorded.
+    if (cl.recording || ::playback || !::isClient || !cl.publicData().inGame)
         return false;
 
-    // Compose the real file name.
-    ddstring_t buf; Str_Appendf(Str_InitStd(&buf), "%s%s", ::demoPath, fileName);
-    F_ExpandBasePath(&buf, &buf);
-    F_ToNativeSlashes(&buf, &buf);
+    DemoRecorder &rec = recorders[plrNum];
+    try
+    {
+        File &file = FS::rootFolder().replaceFile(composeDemoPath(fileName));
+        rec.file = maybeAs<ByteArrayFile>(file);
+        if (!rec.file) return false;
 
-    // Open the demo file.
-    cl->demo = lzOpen(Str_Text(&buf), "wp");
-    Str_Free(&buf);
-    if(!cl->demo)
+        Writer writer(*rec.file);
+        writer.writeBytes(ByteRefArray(DEMO_MAGIC, 4));
+        writer << DEMO_FORMAT_VERSION;
+        rec.offset = writer.offset();
+    }
+    catch (Error const &er)
     {
-        return false;  // Couldn't open it!
+        LOG_NET_ERROR("Failed to begin recording: %s") << er.asText();
+        rec = DemoRecorder();
+        return false;
     }
 
-    cl->recording    = true;
-    cl->recordPaused = false;
+    cl.recording    = true;
+    cl.recordPaused = false;
 
-    ::writeInfo[plrNum].first       = true;
-    ::writeInfo[plrNum].canwrite    = false;
-    ::writeInfo[plrNum].cameratimer = 0;
-    ::writeInfo[plrNum].fov         = -1;  // Must be written in the first packet.
+    DemoTimer &inf  = cl.demoTimer();
+    inf.first       = true;
+    inf.canwrite    = false;
+    inf.cameratimer = 0;
+    inf.fov         = -1;  // Must be written in the first packet.
 
-    if(::isServer)
-    {
-        // Playing demos alters gametic. This'll make sure we're going to get updates.
-        ::clients[0].lastTransmit = -1;
-        // Servers need to send a handshake packet.
-        // It only needs to recorded in the demo file, though.
-        ::allowSending = false;
-        Sv_Handshake(plrNum, false);
-        // Enable sending to network.
-        ::allowSending = true;
-    }
-    else
-    {
-        // Clients need a Handshake packet.
-        // Request a new one from the server.
-        Cl_SendHello();
-    }
+    // Clients need a Handshake packet.
+    // Request a new one from the server.
+    Cl_SendHello();
 
     // The operation is a success.
     return true;
-#endif
 }
 
 void Demo_PauseRecording(dint playerNum)
@@ -188,14 +213,17 @@ void Demo_StopRecording(dint playerNum)
     if(!cl.recording) return;
 
     // Close demo file.
-    //lzClose(cl.demo); cl.demo = nullptr;
+    DemoRecorder &rec = recorders[playerNum];
+    if (rec.file)
+    {
+        rec.file->flush();
+    }
+    rec = DemoRecorder();
     cl.recording = false;
 }
 
 void Demo_WritePacket(dint playerNum)
 {
-    DENG_UNUSED(playerNum);
-#if 0
     if(playerNum < 0)
     {
         Demo_BroadcastPacket();
@@ -227,17 +255,13 @@ void Demo_WritePacket(dint playerNum)
             return;
     }
 
-    // This counts as an update. (We know the client is alive.)
-    //::clients[playerNum].updateCount = UPDATECOUNT;
-
-    LZFILE *file = cl.demo;
-    if(!file) App_Error("Demo_WritePacket: No demo file!\n");
+    DemoRecorder &rec = recorders[playerNum];
+    DENG2_ASSERT(rec.file);
 
-    byte ptime;
+    duint32 ptime;
     if(!inf.first)
     {
-        ptime = (cl.recordPaused ? inf.pausetime : DEMOTIC)
-              - inf.begintime;
+        ptime = (cl.recordPaused ? inf.pausetime : DEMOTIC) - inf.begintime;
     }
     else
     {
@@ -245,19 +269,21 @@ void Demo_WritePacket(dint playerNum)
         inf.first     = false;
         inf.begintime = DEMOTIC;
     }
-    lzWrite(&ptime, 1, file);
-
-    demopacket_header_t hdr;  // The header.
-    if(::netBuffer.length >= sizeof(hdr.length))
-        App_Error("Demo_WritePacket: Write buffer too large!\n");
 
-    hdr.length = (dushort) 1 + ::netBuffer.length;
-    lzWrite(&hdr, sizeof(hdr), file);
-
-    // Write the packet itself.
-    lzPutC(::netBuffer.msg.type, file);
-    lzWrite(::netBuffer.msg.data, (long) netBuffer.length, file);
-#endif
+    try
+    {
+        Writer writer(*rec.file, littleEndianByteOrder, rec.offset);
+        writer << ptime
+               << duint8(::netBuffer.msg.type)
+               << duint32(::netBuffer.length);
+        writer.writeBytes(ByteRefArray(::netBuffer.msg.data, ::netBuffer.length));
+        rec.offset = writer.offset();
+    }
+    catch (Error const &er)
+    {
+        LOG_NET_ERROR("Demo recording stopped: %s") << er.asText();
+        Demo_StopRecording(playerNum);
+    }
 }
 
 void Demo_BroadcastPacket()
@@ -269,6 +295,14 @@ void Demo_BroadcastPacket()
     }
 }
 
+static bool readNextPacketTime()
+{
+    if (playDemo.offset + 4 > playDemo.file->size()) return false;
+    Reader(*playDemo.file, littleEndianByteOrder, playDemo.offset) >> playDemo.nextPacketTime;
+    playDemo.offset += 4;
+    return true;
+}
+
 dd_bool Demo_BeginPlayback(char const *fileName)
 {
     // Already in playback?
@@ -283,45 +317,54 @@ dd_bool Demo_BeginPlayback(char const *fileName)
             return false;
     }
 
-    // Compose the real file name.
-    ddstring_t buf; Str_Set(Str_InitStd(&buf), fileName);
-    if(!F_IsAbsolute(&buf))
-    {
-        Str_Prepend(&buf, demoPath);
-    }
-    F_ExpandBasePath(&buf, &buf);
-    F_ToNativeSlashes(&buf, &buf);
-
     // Open the demo file.
-#if 0
-    playdemo = lzOpen(Str_Text(&buf), "rp");
-#endif
-    Str_Free(&buf);
+    try
+    {
+        playDemo = DemoPlayer();
+        playDemo.file = &FS::rootFolder().locate<ByteArrayFile const>(composeDemoPath(fileName));
 
-#if 0
-    if(!playdemo)
-#endif
+        Block magic(4);
+        duint32 version;
+        Reader reader(*playDemo.file);
+        reader.readBytesFixedSize(magic) >> version;
+        if (magic != QByteArray(DEMO_MAGIC, 4) || version > DEMO_FORMAT_VERSION)
+        {
+            LOG_NET_ERROR("\"%s\" is not a supported demo file") << fileName;
+            playDemo = DemoPlayer();
+            return false;
+        }
+        playDemo.offset = reader.offset();
+        if (!readNextPacketTime())
+        {
+            LOG_NET_ERROR("Demo \"%s\" contains no packets") << fileName;
+            playDemo = DemoPlayer();
+            return false;
+        }
+    }
+    catch (Error const &er)
+    {
+        LOG_NET_ERROR("Failed to open demo: %s") << er.asText();
+        playDemo = DemoPlayer();
         return false;
+    }
 
     // OK, let's begin the demo.
     ::playback       = true;
     ::isServer       = false;
     ::isClient       = true;
-    ::readInfo.first = true;
     ::viewangleDelta = 0;
     ::lookdirDelta   = 0;
     ::demoFrameZ     = 1;
     ::demoZ          = 0;
-    ::startFOV       = 95; //Rend_FieldOfView();
-    ::demoStartTic   = DEMOTIC;
     std::memset(::posDelta, 0, sizeof(::posDelta));
 
-    // Start counting frames from here.
-    /*if(ArgCheck("-timedemo"))
-    {
-        ::r_framecounter = 0;
-    }*/
+    return true;
+}
 
+dd_bool Demo_BeginTimeDemo(char const *fileName)
+{
+    if (!Demo_BeginPlayback(fileName)) return false;
+    TicTimings_Begin(0);
     return true;
 }
 
@@ -329,44 +372,27 @@ void Demo_StopPlayback()
 {
     if(!::playback) return;
 
-#if 0
-    LOG_MSG("Demo was %.2f seconds (%i tics) long.")
-        << ((DEMOTIC - ::demoStartTic) / dfloat( TICSPERSEC ))
-        << (DEMOTIC - ::demoStartTic);
+    LOG_MSG("Demo was %.2f seconds (%i tics) long")
+        << (playDemo.tic / dfloat(TICSPERSEC))
+        << playDemo.tic;
+
+    TicTimings_End();
 
     ::playback = false;
-    lzClose(::playdemo); playdemo = nullptr;
-    //::fieldOfView = ::startFOV;
+    playDemo = DemoPlayer();
     Net_StopGame();
 
-    /*if(ArgCheck("-timedemo"))
-    {
-        diff = Sys_GetSeconds() - ::netConnectTime;
-        if(!diff) diff = 1;
-
-        // Print summary and exit.
-        LOG_MSG("Timedemo results: %i game tics in %.1f seconds", ::r_framecounter, diff);
-        LOG_MSG("%f FPS", ::r_framecounter / diff);
-        Sys_Quit();
-    }*/
-
     // "Play demo once" mode?
-    if(CommandLine_Check("-playdemo"))
+    if(CommandLine_Check("-playdemo") || CommandLine_Check("-timedemo"))
         Sys_Quit();
-#endif
 }
 
 dd_bool Demo_ReadPacket()
 {
-    return false;
-#if 0
-    static byte ptime;
-    dint nowtime = DEMOTIC;
-
-    if(!playback)
+    if(!::playback)
         return false;
 
-    if(lzEOF(::playdemo))
+    if(!playDemo.file)
     {
         Demo_StopPlayback();
         // Any interested parties?
@@ -374,33 +400,41 @@ dd_bool Demo_ReadPacket()
         return false;
     }
 
-    if(::readInfo.first)
-    {
-        ::readInfo.first = false;
-        ::readInfo.begintime = nowtime;
-        ptime = lzGetC(::playdemo);
-    }
-
-    // Check if the packet can be read.
-    if(Net_TimeDelta(nowtime - ::readInfo.begintime, ptime) < 0)
+    // Check if the packet can be read. Playback advances one recorded tic per
+    // game tic, so the packets are always delivered on the same tics.
+    if(playDemo.nextPacketTime > playDemo.tic)
         return false;  // Can't read yet.
 
     // Read the packet.
-    demopacket_header_t hdr;
-    lzRead(&hdr, sizeof(hdr), ::playdemo);
-
-    // Get the packet.
-    ::netBuffer.length = hdr.length - 1;
-    ::netBuffer.player = 0; // From the server.
-    ::netBuffer.msg.type = lzGetC(::playdemo);
-    lzRead(::netBuffer.msg.data, (long) ::netBuffer.length, ::playdemo);
-    //::netBuffer.cursor = ::netBuffer.msg.data;
+    try
+    {
+        Reader reader(*playDemo.file, littleEndianByteOrder, playDemo.offset);
+        duint32 length;
+        reader.readAs<duint8>(::netBuffer.msg.type) >> length;
+        if(length > sizeof(::netBuffer.msg.data))
+        {
+            throw Error("Demo_ReadPacket", "Packet too large");
+        }
+        ByteRefArray data(::netBuffer.msg.data, length);
+        reader.readBytesFixedSize(data);
+        ::netBuffer.length = length;
+        ::netBuffer.player = 0; // From the server.
+        playDemo.offset = reader.offset();
+    }
+    catch (Error const &er)
+    {
+        LOG_NET_ERROR("Demo playback stopped: %s") << er.asText();
+        playDemo.file = nullptr;
+        return false;
+    }
 
     // Read the next packet time.
-    ptime = lzGetC(::playdemo);
-
+    if(!readNextPacketTime())
+    {
+        // This was the last packet.
+        playDemo.file = nullptr;
+    }
     return true;
-#endif
 }
 
 /**
@@ -548,6 +582,9 @@ void Demo_Ticker(timespan_t /*time*/)
     // Only playback is handled.
     if(::playback)
     {
+        // Advance the demo time.
+        playDemo.tic++;
+
         DENG2_ASSERT(::consolePlayer >= 0 && ::consolePlayer < DDMAXPLAYERS);
         player_t   *plr  = DD_Player(::consolePlayer);
         ddplayer_t *ddpl = &plr->publicData();
@@ -586,6 +623,14 @@ D_CMD(PlayDemo)
     return Demo_BeginPlayback(argv[1]);
 }
 
+D_CMD(TimeDemo)
+{
+    DENG2_UNUSED2(src, argc);
+
+    LOG_MSG("Playing timedemo \"%s\"...") << argv[1];
+    return Demo_BeginTimeDemo(argv[1]);
+}
+
 D_CMD(RecordDemo)
 {
     DENG2_UNUSED(src);
@@ -718,4 +763,5 @@ void Demo_Register()
     C_CMD_FLAGS("playdemo",     "s",        PlayDemo,   CMDF_NO_NULLGAME);
     C_CMD_FLAGS("recorddemo",   nullptr,    RecordDemo, CMDF_NO_NULLGAME);
     C_CMD_FLAGS("stopdemo",     nullptr,    StopDemo,   CMDF_NO_NULLGAME);
+    C_CMD_FLAGS("timedemo",     "s",        TimeDemo,   CMDF_NO_NULLGAME);
 }
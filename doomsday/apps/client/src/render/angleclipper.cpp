@@ -21,6 +21,7 @@
 #include "render/angleclipper.h"
 
 #include <QVector>
+#include <algorithm>
 #include <de/Error>
 #include <de/Log>
 #include <doomsday/console/var.h>
@@ -150,14 +151,10 @@ using namespace ::internal;
 
 DENG2_PIMPL_NOREF(AngleClipper)
 {
-    /// Specialized AngleRange for half-space clipping.
-    struct Clipper : public ElementPool::Element, AngleRange
-    {
-        Clipper *prev;
-        Clipper *next;
-    };
-    ElementPool clipNodes;         ///< The list of clipnodes.
-    Clipper *clipHead = nullptr;   ///< Head of the clipped-range list.
+    /// Clipped ranges, sorted by start angle. The ranges never overlap or touch
+    /// each other, so the end angles are sorted, too.
+    typedef QVector<AngleRange> ClipRanges;
+    ClipRanges clipRanges;
 
     /// Specialized AngleRange for half-space occlusion.
     struct Occluder : public ElementPool::Element, AngleRange
@@ -172,10 +169,19 @@ DENG2_PIMPL_NOREF(AngleClipper)
     Occluder *occHead = nullptr;   ///< Head of the occlusion-range list.
 
     QVector<binangle_t> angleBuf;  ///< Scratch buffer for sorting angles.
+    Recording *recording = nullptr;
+
+    /// Appends a call to the recording, if one is being made.
+    void record(Recording::Op op, binangle_t from = 0, binangle_t to = 0,
+                Vector3d const &fromPoint = Vector3d(), Vector3d const &toPoint = Vector3d(),
+                coord_t height = 0, bool topHalf = false, Face const *poly = nullptr)
+    {
+        if(!recording) return;
+        recording->calls << Recording::Call{ op, from, to, fromPoint, toPoint, height, topHalf, poly };
+    }
 
     ~Impl()
     {
-        clearRangeList(&clipHead);
         clearRangeList(&occHead);
     }
 
@@ -192,17 +198,38 @@ DENG2_PIMPL_NOREF(AngleClipper)
     }
 
     /**
-     * The specified range must be safe!
+     * Returns the index of the first clipped range starting after @a angle.
      */
-    dint isRangeVisible(binangle_t from, binangle_t to) const
+    dint clipRangeAfter(binangle_t angle) const
+    {
+        return dint(std::upper_bound(clipRanges.begin(), clipRanges.end(), angle,
+                                     [] (binangle_t a, AngleRange const &range) {
+            return a < range.from;
+        }) - clipRanges.begin());
+    }
+
+    dint isAngleVisible(binangle_t bang) const
     {
-        for(Clipper *i = clipHead; i; i = i->next)
+        // Only the last range starting before the angle may contain it.
+        dint const idx = clipRangeAfter(bang);
+        if(idx > 0)
         {
-            if(from >= i->from && to <= i->to)
+            AngleRange const &crange = clipRanges.at(idx - 1);
+            if(bang > crange.from && bang < crange.to)
                 return false;
         }
-        // No clip-node fully contained the specified range.
-        return true;
+
+        return true;  // Not occluded.
+    }
+
+    /**
+     * The specified range must be safe!
+     */
+    dint isRangeVisible(binangle_t from, binangle_t to) const
+    {
+        // Only the last range starting at or before @a from may contain the range.
+        dint const idx = clipRangeAfter(from);
+        return !idx || to > clipRanges.at(idx - 1).to;
     }
 
     /**
@@ -218,38 +245,20 @@ DENG2_PIMPL_NOREF(AngleClipper)
         return isRangeVisible(from, to);
     }
 
-    void removeRange(Clipper *crange)
+    void safeAddRange(binangle_t from, binangle_t to)
     {
-        // If this is the head, move it.
-        if(clipHead == crange)
-            clipHead = crange->next;
-
-        if(crange->prev)
-            crange->prev->next = crange->next;
-        if(crange->next)
-            crange->next->prev = crange->prev;
-
-        // We're done with this range - mark it as free for reuse.
-        clipNodes.release(crange);
-    }
-
-    Clipper *newClipNode(binangle_t from, binangle_t to)
-    {
-        // Perhaps a previously-used clip-node can be reused?
-        auto *crange = reinterpret_cast<Clipper *>(clipNodes.get());
-        if(!crange)
+        // The range may wrap around.
+        if(from > to)
         {
-            // No, allocate another.
-            clipNodes.add(crange = new Clipper);
+            // The range has to added in two parts.
+            addRange(from, BANG_MAX);
+            addRange(0, to);
+        }
+        else
+        {
+            // Add the range as usual.
+            addRange(from, to);
         }
-
-        // (Re)Configure.
-        crange->from = from;
-        crange->to   = to;
-        crange->prev = nullptr;
-        crange->next = nullptr;
-
-        return crange;
     }
 
     void addRange(binangle_t from, binangle_t to)
@@ -258,186 +267,27 @@ DENG2_PIMPL_NOREF(AngleClipper)
         // corresponding occlusion range.
         cutOcclusionRange(from, to);
 
-        // If there is no head, this will be the first range.
-        if(!clipHead)
-        {
-            clipHead = newClipNode(from, to);
-
-            /*
-            LOG_AS("AngleClipper::addRange");
-            LOG_DEBUG(String("New head added: %1 => %2")
-                        .arg(clipHead->from, 0, 16)
-                        .arg(clipHead->to,   0, 16));
-            */
-            return;
-        }
-
-        // There are previous ranges. Check that the new range isn't contained
-        // by any of them.
-        for(Clipper *i = clipHead; i; i = i->next)
-        {
-            /*
-            LOG_AS("AngleClipper::addRange");
-            LOG_DEBUG(String("0x%1: %2 => %3")
-                        .arg((quintptr)i, QT_POINTER_SIZE * 2, 16, QChar('0'))
-                        .arg(i->from, 0, 16)
-                        .arg(i->to,   0, 16));
-            */
-
-            if(from >= i->from && to <= i->to)
-            {
-                /*
-                LOG_AS("AngleClipper::addRange");
-                LOG_DEBUG("Range already exists");
-                */
-                return;  // The new range already exists.
-            }
-
-#ifdef DENG2_DEBUG
-            if(i == i->next)
-                throw Error("AngleClipper::addRange", String("loop1 0x%1 linked to itself: %2 => %3")
-                                                        .arg((quintptr)i, QT_POINTER_SIZE * 2, 16, QChar('0'))
-                                                        .arg(i->from, 0, 16)
-                                                        .arg(i->to,   0, 16));
-#endif
-        }
-
-        // Now check if any of the old ranges are contained by the new one.
-        for(Clipper *i = clipHead; i;)
-        {
-            if(i->from >= from && i->to <= to)
-            {
-                Clipper *contained = i;
-
-                /*
-                LOG_AS("AngleClipper::addRange");
-                LOG_DEBUG(String("Removing contained range %1 => %2")
-                            .arg(contained->from, 0, 16)
-                            .arg(contained->to,   0, 16));
-                */
-
-                i = i->next;
-                removeRange(contained);
-                continue;
-            }
-
-            i = i->next;
-        }
+        // Find the ranges that overlap or touch the new one: [first, last).
+        dint const first = dint(std::lower_bound(clipRanges.begin(), clipRanges.end(), from,
+                                                 [] (AngleRange const &range, binangle_t a) {
+            return range.to < a;
+        }) - clipRanges.begin());
+        dint const last = clipRangeAfter(to);
 
-        // Now it is possible that the new range overlaps one or two old ranges.
-        // If two are overlapped, they are consecutive. First we'll try to find
-        // a range that overlaps the beginning.
-        Clipper *crange = nullptr;
-        for(Clipper *i = clipHead; i; i = i->next)
+        if(first >= last)
         {
-            // In preparation for the next stage, find a good spot for the range.
-            if(i->from < to)
-            {
-                // After this one.
-                crange = i;
-            }
-
-            if(i->from >= from && i->from <= to)
-            {
-                // New range's end and i's beginning overlap. i's end is outside.
-                // Otherwise it would have been already removed.
-                // It suffices to adjust i.
-
-                /*
-                LOG_AS("AngleClipper::addRange");
-                LOG_DEBUG(String("Overlapping start: %1 => %2 - adjusting to %3 => %4")
-                            .arg(i->from, 0, 16)
-                            .arg(i->to,   0, 16)
-                            .arg(from,    0, 16)
-                            .arg(i->to,   0, 16));
-                */
-
-                i->from = from;
-                return;
-            }
-
-            // Check an overlapping end.
-            if(i->to >= from && i->to <= to)
-            {
-                // Now it's possible that the i->next's beginning overlaps the
-                // new range's end. In that case there will be a merger.
-
-                /*
-                LOG_AS("AngleClipper::addRange");
-                LOG_DEBUG(String("Overlapping end: %1 => %2")
-                            .arg(i->from, 0, 16)
-                            .arg(i->to,   0, 16));
-                */
-
-                crange = i->next;
-                if(!crange)
-                {
-                    i->to = to;
-
-                    /*
-                    LOG_AS("AngleClipper::addRange");
-                    LOG_DEBUG(String("No next, adjusting end (now %1 => %2)")
-                                .arg(i->from, 0, 16)
-                                .arg(i->to,   0, 16));
-                    */
-                }
-                else
-                {
-                    if(crange->from <= to)
-                    {
-                        // A fusion will commence. Ci will eat the new range
-                        // *and* crange.
-                        i->to = crange->to;
-
-                        /*
-                        LOG_AS("AngleClipper::addRange");
-                        LOG_DEBUG(String("merging with the next (%1 => %2)")
-                                    .arg(crange->from, 0, 16)
-                                    .arg(crange->to,   0, 16));
-                        */
-
-                        removeRange(crange);
-                    }
-                    else
-                    {
-                        // Not overlapping.
-                        i->to = to;
-
-                        /*
-                        LOG_AS("AngleClipper::addRange");
-                        LOG_DEBUG(String("Not merger w/next (now %1 => %2)")
-                                    .arg(i->from, 0, 16)
-                                    .arg(i->to,   0, 16));
-                        */
-                    }
-                }
-
-                return;
-            }
+            // Disconnected from the others.
+            clipRanges.insert(first, AngleRange(from, to));
+            return;
         }
 
-        // Still here? Now we know for sure that the range is disconnected from
-        // the others. We still need to find a good place for it. Crange will
-        // mark the spot.
-
-        if(!crange)
-        {
-            // We have a new head.
-            crange = clipHead;
-            clipHead = newClipNode(from, to);
-            clipHead->next = crange;
-            if(crange)
-                crange->prev = clipHead;
-        }
-        else
+        // Merge everything into the first overlapped range.
+        AngleRange &merged = clipRanges[first];
+        merged.from = de::min(merged.from, from);
+        merged.to   = de::max(clipRanges.at(last - 1).to, to);
+        if(last - first > 1)
         {
-            // Add the new range after crange.
-            Clipper *added = newClipNode(from, to);
-            added->next = crange->next;
-            if(added->next)
-                added->next->prev = added;
-            added->prev = crange;
-            crange->next = added;
+            clipRanges.remove(first + 1, last - first - 1);
         }
     }
 
@@ -771,41 +621,43 @@ AngleClipper::AngleClipper() : d(new Impl)
 
 dint AngleClipper::isFull() const
 {
+    d->record(Recording::IsFull);
+
     if(::devNoCulling) return false;
 
-    return d->clipHead && d->clipHead->from == 0 && d->clipHead->to == BANG_MAX;
+    return d->clipRanges.count() == 1 && d->clipRanges.first().from == 0
+                                      && d->clipRanges.first().to   == BANG_MAX;
 }
 
 dint AngleClipper::isAngleVisible(binangle_t bang) const
 {
-    if(::devNoCulling) return true;
+    d->record(Recording::IsAngleVisible, bang);
 
-    for(Impl::Clipper const *crange = d->clipHead; crange; crange = crange->next)
-    {
-        if(bang > crange->from && bang < crange->to)
-            return false;
-    }
+    if(::devNoCulling) return true;
 
-    return true;  // Not occluded.
+    return d->isAngleVisible(bang);
 }
 
 dint AngleClipper::isPointVisible(Vector3d const &point) const
 {
+    d->record(Recording::IsPointVisible, 0, 0, point);
+
     if(::devNoCulling) return true;
 
     Vector3d const viewRelPoint = point - Rend_EyeOrigin().xzy();
     binangle_t const angle      = pointToAngle(viewRelPoint);
 
-    if(!isAngleVisible(angle)) return false;
+    if(!d->isAngleVisible(angle)) return false;
 
     // Not clipped by the clipnodes. Perhaps it's occluded by an orange.
     for(Impl::Occluder const *orange = d->occHead; orange; orange = orange->next)
     {
-        if(angle >= orange->from && angle <= orange->to)
-        {
-            if(orange->from > angle)
-                return true;  // No more possibilities.
+        // The oranges are sorted by the start angle.
+        if(orange->from > angle)
+            return true;  // No more possibilities.
 
+        if(angle <= orange->to)
+        {
             // On which side of the occlusion plane is it?
             // The positive side is the occluded one.
             if(viewRelPoint.dot(orange->normal) > 0)
@@ -820,6 +672,8 @@ dint AngleClipper::isPolyVisible(Face const &poly) const
 {
     DENG2_ASSERT(poly.isConvex());
 
+    d->record(Recording::IsPolyVisible, 0, 0, Vector3d(), Vector3d(), 0, false, &poly);
+
     if(::devNoCulling) return true;
 
     // Do we need to resize the angle list buffer?
@@ -868,8 +722,9 @@ dint AngleClipper::isPolyVisible(Face const &poly) const
 
 void AngleClipper::clearRanges()
 {
-    d->clipHead = nullptr;
-    d->clipNodes.rewind();  // Start reusing ranges.
+    d->record(Recording::ClearRanges);
+
+    d->clipRanges.clear();  // Capacity is retained for the next frame.
 
     d->occHead = nullptr;
     d->occNodes.rewind();   // Start reusing ranges.
@@ -877,32 +732,27 @@ void AngleClipper::clearRanges()
 
 dint AngleClipper::safeAddRange(binangle_t from, binangle_t to)
 {
-    // The range may wrap around.
-    if(from > to)
-    {
-        // The range has to added in two parts.
-        d->addRange(from, BANG_MAX);
-        d->addRange(0, to);
-    }
-    else
-    {
-        // Add the range as usual.
-        d->addRange(from, to);
-    }
+    d->record(Recording::SafeAddRange, from, to);
+
+    d->safeAddRange(from, to);
     return true;
 }
 
 void AngleClipper::addRangeFromViewRelPoints(Vector2d const &from, Vector2d const &to)
 {
+    d->record(Recording::AddRangeFromViewRelPoints, 0, 0, Vector3d(from), Vector3d(to));
+
     Vector2d const eyeOrigin = Rend_EyeOrigin().xz();
-    safeAddRange(pointToAngle(to   - eyeOrigin),
-                 pointToAngle(from - eyeOrigin));
+    d->safeAddRange(pointToAngle(to   - eyeOrigin),
+                    pointToAngle(from - eyeOrigin));
 }
 
 /// @todo Optimize:: Check if the given line is already occluded?
 void AngleClipper::addViewRelOcclusion(Vector2d const &from, Vector2d const &to,
     coord_t height, bool topHalf)
 {
+    d->record(Recording::AddViewRelOcclusion, 0, 0, Vector3d(from), Vector3d(to), height, topHalf);
+
     // Calculate the occlusion plane normal.
     // We'll use the game's coordinate system (left-handed, but Y and Z are swapped).
     Vector3d const eyeOrigin    = Rend_EyeOrigin().xzy();
@@ -935,6 +785,8 @@ void AngleClipper::addViewRelOcclusion(Vector2d const &from, Vector2d const &to,
 
 dint AngleClipper::checkRangeFromViewRelPoints(Vector2d const &from, Vector2d const &to)
 {
+    d->record(Recording::CheckRangeFromViewRelPoints, 0, 0, Vector3d(from), Vector3d(to));
+
     if(::devNoCulling) return true;
 
     Vector2d const eyeOrigin = Rend_EyeOrigin().xz();
@@ -942,33 +794,72 @@ dint AngleClipper::checkRangeFromViewRelPoints(Vector2d const &from, Vector2d co
                              pointToAngle(from - eyeOrigin) + BANG_45/90);
 }
 
-#ifdef DENG2_DEBUG
-void AngleClipper::validate()
+void AngleClipper::setRecording(Recording *recording)
 {
-    for(Impl::Clipper *i = d->clipHead; i; i = i->next)
+    d->recording = recording;
+}
+
+dint AngleClipper::replay(Recording const &recording)
+{
+    dint visibleCount = 0;
+    for(Recording::Call const &call : recording.calls)
     {
-        if(i == d->clipHead)
+        switch(call.op)
         {
-            if(i->prev)
-                throw Error("AngleClipper::validate", "Cliphead->prev != NULL");
-        }
+        case Recording::ClearRanges:
+            clearRanges();
+            break;
 
-        // Confirm that the links to prev and next are OK.
-        if(i->prev)
-        {
-            if(i->prev->next != i)
-                throw Error("AngleClipper::validate", "Prev->next != this");
-        }
-        else if(i != d->clipHead)
-        {
-            throw Error("AngleClipper::validate", "prev == NULL, this isn't clipHead");
-        }
+        case Recording::SafeAddRange:
+            safeAddRange(call.from, call.to);
+            break;
 
-        if(i->next)
-        {
-            if(i->next->prev != i)
-                throw Error("AngleClipper::validate", "Next->prev != this");
+        case Recording::AddRangeFromViewRelPoints:
+            addRangeFromViewRelPoints(Vector2d(call.fromPoint), Vector2d(call.toPoint));
+            break;
+
+        case Recording::AddViewRelOcclusion:
+            addViewRelOcclusion(Vector2d(call.fromPoint), Vector2d(call.toPoint),
+                                call.height, call.topHalf);
+            break;
+
+        case Recording::CheckRangeFromViewRelPoints:
+            if(checkRangeFromViewRelPoints(Vector2d(call.fromPoint), Vector2d(call.toPoint)))
+                visibleCount++;
+            break;
+
+        case Recording::IsFull:
+            if(!isFull()) visibleCount++;
+            break;
+
+        case Recording::IsAngleVisible:
+            if(isAngleVisible(call.from)) visibleCount++;
+            break;
+
+        case Recording::IsPointVisible:
+            if(isPointVisible(call.fromPoint)) visibleCount++;
+            break;
+
+        case Recording::IsPolyVisible:
+            if(isPolyVisible(*call.poly)) visibleCount++;
+            break;
         }
     }
+    return visibleCount;
+}
+
+#ifdef DENG2_DEBUG
+void AngleClipper::validate()
+{
+    for(dint i = 0; i < d->clipRanges.count(); ++i)
+    {
+        AngleRange const &crange = d->clipRanges.at(i);
+        if(crange.from > crange.to)
+            throw Error("AngleClipper::validate", String("Range %1 is inverted").arg(i));
+
+        // Ranges must be sorted and must not overlap or touch.
+        if(i > 0 && d->clipRanges.at(i - 1).to >= crange.from)
+            throw Error("AngleClipper::validate", String("Range %1 overlaps the previous").arg(i));
+    }
 }
 #endif
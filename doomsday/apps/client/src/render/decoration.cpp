@@ -64,6 +64,11 @@ MaterialAnimator::Decoration const &Decoration::source() const
     return *d->source;
 }
 
+void Decoration::setSource(MaterialAnimator::Decoration const &newSource)
+{
+    d->source = &newSource;
+}
+
 bool Decoration::hasSurface() const
 {
     return d->surface != nullptr;
@@ -22,13 +22,58 @@
 #include "render/drawlists.h"
 
 #include <de/Log>
+#include <de/Time>
 #include <de/memoryzone.h>
 #include <QMultiHash>
 #include <QtAlgorithms>
+#include <algorithm>
 
 using namespace de;
 
-typedef QMultiHash<GLuint, DrawList *> DrawListHash;
+/**
+ * Identifies the textures of the primary units of a list specification. Lists with
+ * the same key differ only in opacity or in the interpolation target.
+ */
+struct DrawListKey
+{
+    duint64 primary;
+    duint64 detail;
+
+    bool operator == (DrawListKey const &other) const {
+        return primary == other.primary && detail == other.detail;
+    }
+};
+
+static inline uint qHash(DrawListKey const &key)
+{
+    return ::qHash(key.primary) ^ (::qHash(key.detail) * 31);
+}
+
+/**
+ * Returns a value identifying the texture and its GL state in @a unit. Managed
+ * textures are identified by the (aligned) variant pointer, unmanaged ones by
+ * the GL name and parameters with the lowest bit set.
+ */
+static duint64 unitKey(GLTextureUnit const &unit)
+{
+    if(unit.texture)
+    {
+        return duint64(reinterpret_cast<quintptr>(unit.texture));
+    }
+    return (duint64(unit.unmanaged.glName)     << 16) |
+           (duint64(unit.unmanaged.wrapS  & 0xf) << 9) |
+           (duint64(unit.unmanaged.wrapT  & 0xf) << 5) |
+           (duint64(unit.unmanaged.filter & 0xf) << 1) | 1;
+}
+
+static DrawListKey listKey(DrawListSpec const &spec)
+{
+    // Shine lists do not use the detail units.
+    return DrawListKey{ unitKey(spec.unit(TU_PRIMARY)),
+                        spec.group == ShineGeom? 0 : unitKey(spec.unit(TU_PRIMARY_DETAIL)) };
+}
+
+typedef QMultiHash<DrawListKey, DrawList *> DrawListHash;
 
 DENG2_PIMPL(DrawLists)
 {
@@ -39,6 +84,9 @@ DENG2_PIMPL(DrawLists)
     DrawListHash shinyHash;
     DrawListHash shadowHash;
 
+    bool collectStats = false;
+    Statistics stats;
+
     Impl(Public *i) : Base(i)
     {
         DrawListSpec newSpec;
@@ -146,20 +194,36 @@ static bool compareTexUnit(GLTextureUnit const &lhs, GLTextureUnit const &rhs)
 DrawList &DrawLists::find(DrawListSpec const &spec)
 {
     // Sky masked geometry is never textured; therefore no draw list hash.
-    /// @todo Make hash management dynamic. -ds
     if(spec.group == SkyMaskGeom)
     {
         return *d->skyMaskList;
     }
 
+    if(!d->collectStats)
+    {
+        return findList(spec);
+    }
+
+    ddouble const startedAt = ddouble(TimeSpan::sinceStartOfProcess());
+    DrawList &found = findList(spec);
+    d->stats.findTime += ddouble(TimeSpan::sinceStartOfProcess()) - startedAt;
+    d->stats.findCount++;
+    return found;
+}
+
+DrawList &DrawLists::findList(DrawListSpec const &spec)
+{
     DrawList *convertable = 0;
 
-    // Find/create a list in the hash.
-    GLuint const key  = spec.unit(TU_PRIMARY).getTextureGLName();
+    // Find/create a list in the hash. All the lists in the bucket use the same
+    // primary textures, leaving only opacity and interpolation to compare.
+    DrawListKey const key = listKey(spec);
     DrawListHash &hash = d->listHash(spec.group);
     for(DrawListHash::const_iterator it = hash.find(key);
         it != hash.end() && it.key() == key; ++it)
     {
+        if(d->collectStats) d->stats.probeCount++;
+
         DrawList *list = it.value();
         DrawListSpec const &listSpec = list->spec();
 
@@ -213,6 +277,7 @@ DrawList &DrawLists::find(DrawListSpec const &spec)
     }
 
     // Create a new list.
+    if(d->collectStats) d->stats.createdCount++;
     return *hash.insert(key, new DrawList(spec)).value();
 }
 
@@ -236,7 +301,33 @@ int DrawLists::findAll(GeomGroup group, FoundLists &found)
                 found.append(list);
             }
         }
+
+        // Hash order is arbitrary; draw the lists sharing textures
+        // consecutively so that fewer texture changes are needed.
+        std::sort(found.begin(), found.end(), [] (DrawList const *a, DrawList const *b) {
+            for(int unit : { TU_PRIMARY, TU_PRIMARY_DETAIL, TU_INTER, TU_INTER_DETAIL })
+            {
+                GLuint const aName = a->spec().unit(unit).getTextureGLName();
+                GLuint const bName = b->spec().unit(unit).getTextureGLName();
+                if(aName != bName) return aName < bName;
+            }
+            return false;
+        });
     }
 
     return found.count();
 }
+
+void DrawLists::setCollectStatistics(bool enabled)
+{
+    d->collectStats = enabled;
+    if(enabled)
+    {
+        d->stats = Statistics();
+    }
+}
+
+DrawLists::Statistics const &DrawLists::statistics() const
+{
+    return d->stats;
+}
@@ -23,14 +23,18 @@
 using namespace de;
 
 ProjectionList::Node *ProjectionList::firstNode = nullptr;
+ProjectionList::Node *ProjectionList::lastNode = nullptr;
 ProjectionList::Node *ProjectionList::cursorNode = nullptr;
 
+static dint const NODE_BLOCK_SIZE = 256;  ///< Nodes allocated at once.
+
 void ProjectionList::init()  // static
 {
     static bool firstTime = true;
     if(firstTime)
     {
         firstNode  = 0;
+        lastNode   = 0;
         cursorNode = 0;
         firstTime  = false;
     }
@@ -84,23 +88,27 @@ ProjectionList &ProjectionList::add(ProjectedTextureData &texp)
 
 ProjectionList::Node *ProjectionList::newNode()  // static
 {
-    Node *node;
-
     // Do we need to allocate more nodes?
     if(!cursorNode)
     {
-        node = (Node *) Z_Malloc(sizeof(*node), PU_APPSTATIC, nullptr);
+        // Allocate a block of nodes at once and link them to the end of the list, so
+        // that they are reused in order after the next rewind.
+        auto *block = (Node *) Z_Malloc(sizeof(Node) * NODE_BLOCK_SIZE, PU_APPSTATIC, nullptr);
+        for(dint i = 0; i < NODE_BLOCK_SIZE - 1; ++i)
+        {
+            block[i].nextUsed = &block[i + 1];
+        }
+        block[NODE_BLOCK_SIZE - 1].nextUsed = nullptr;
 
-        // Link the new node to the list.
-        node->nextUsed = firstNode;
-        firstNode = node;
-    }
-    else
-    {
-        node = cursorNode;
-        cursorNode = cursorNode->nextUsed;
+        if(lastNode) lastNode->nextUsed = block;
+        else         firstNode = block;
+        lastNode   = &block[NODE_BLOCK_SIZE - 1];
+        cursorNode = block;
     }
 
+    Node *node = cursorNode;
+    cursorNode = cursorNode->nextUsed;
+
     node->next = nullptr;
     return node;
 }
@@ -38,6 +38,7 @@
 #include "gl/gl_tex.h"
 #include "gl/gl_texmanager.h"  // GL_PrepareFlaremap
 
+#include "client/cl_mobj.h"
 #include "network/net_main.h"  // clients[]
 
 #include "render/rendersystem.h"
@@ -113,7 +114,7 @@ static void evaluateLighting(Vector3d const &origin, ConvexSubspace &subspaceAtO
 }
 
 /// @todo use Mobj_OriginSmoothed
-static Vector3d mobjOriginSmoothed(mobj_t *mob)
+static Vector3d mobjOriginSmoothed(mobj_t *mob, bool *interpolated = nullptr)
 {
     DENG2_ASSERT(mob);
     coord_t origin[] = { mob->origin[0], mob->origin[1], mob->origin[2] };
@@ -123,6 +124,12 @@ static Vector3d mobjOriginSmoothed(mobj_t *mob)
     {
         Smoother_Evaluate(DD_Player(P_GetDDPlayerIdx(mob->dPlayer))->smoother(), origin);
     }
+    else
+    {
+        // Remote objects are interpolated between the received snapshots.
+        bool const ok = ClMobj_OriginSmoothed(mob, origin);
+        if(interpolated) *interpolated = ok;
+    }
 
     return origin;
 }
@@ -177,7 +184,8 @@ void R_ProjectSprite(mobj_t &mob)
     ClientMobjThinkerData const *mobjData = THINKER_DATA_MAYBE(mob.thinker, ClientMobjThinkerData);
 
     // Determine distance to object.
-    Vector3d const moPos = mobjOriginSmoothed(&mob);
+    bool isInterpolated = false;
+    Vector3d const moPos = mobjOriginSmoothed(&mob, &isInterpolated);
     coord_t const distFromEye = Rend_PointDist2D(moPos);
 
     // Should we use a 3D model?
@@ -364,9 +372,11 @@ void R_ProjectSprite(mobj_t &mob)
             visOff = Vector3d(mob.srvo) * (mob.tics - frameTimePos) / (float) mob.state->tics;
         }
 
-        if(!INRANGE_OF(mob.mom[0], 0, NOMOMENTUM_THRESHOLD) ||
-           !INRANGE_OF(mob.mom[1], 0, NOMOMENTUM_THRESHOLD) ||
-           !INRANGE_OF(mob.mom[2], 0, NOMOMENTUM_THRESHOLD))
+        // Interpolated remote objects already move smoothly.
+        if(!isInterpolated &&
+           (!INRANGE_OF(mob.mom[0], 0, NOMOMENTUM_THRESHOLD) ||
+            !INRANGE_OF(mob.mom[1], 0, NOMOMENTUM_THRESHOLD) ||
+            !INRANGE_OF(mob.mom[2], 0, NOMOMENTUM_THRESHOLD)))
         {
             // Use the object's speed to calculate a short-range offset.
             // Note that the object may have momentum but still be blocked from moving
@@ -47,6 +47,8 @@
 #include "render/viewports.h"  // R_FrameCount()
 #include "render/store.h"
 
+#include <QHash>
+
 using namespace de;
 using namespace world;
 
@@ -741,6 +743,90 @@ static bool projectWallShadow(WallEdge const &leftEdge, WallEdge const &rightEdg
     return false;
 }
 
+namespace {
+
+/**
+ * Projected shadows of a wall section, reused until the radio data of the line side,
+ * the shadow size, or the heights of the wall or the visual planes change.
+ */
+struct CachedWallShadows
+{
+    duint radioVersion = 0;
+    dfloat shadowSize = 0;
+    coord_t bottom = 0;
+    coord_t top = 0;
+    coord_t floorHeight = 0;
+    coord_t ceilingHeight = 0;
+    bool floorCastsShadow = false;
+    bool ceilingCastsShadow = false;
+
+    bool receives[4];  ///< Indexed by WallShadow.
+    ProjectedShadowData projected[4];
+};
+
+struct CachedWallShadowsKey
+{
+    LineSideSegment const *segment;
+    dint section;
+
+    bool operator == (CachedWallShadowsKey const &other) const
+    {
+        return segment == other.segment && section == other.section;
+    }
+};
+
+inline uint qHash(CachedWallShadowsKey const &key)
+{
+    return ::qHash(key.segment) ^ uint(key.section);
+}
+
+} // namespace
+
+static QHash<CachedWallShadowsKey, CachedWallShadows> wallShadowCache;
+
+/**
+ * Returns the shadows projected on the wall section described by @a leftEdge and
+ * @a rightEdge, projecting them anew only if something has changed.
+ */
+static CachedWallShadows const &projectWallShadows(WallEdge const &leftEdge, WallEdge const &rightEdge,
+    dfloat shadowSize)
+{
+    LineSide const &side = leftEdge.lineSide();
+    auto const &subsec   = side.leftHEdge()->face().mapElementAs<ConvexSubspace>().subsector().as<world::ClientSubsector>();
+    Plane const &visFloor   = subsec.visFloor  ();
+    Plane const &visCeiling = subsec.visCeiling();
+
+    CachedWallShadows &cached = wallShadowCache[CachedWallShadowsKey{ &leftEdge.lineSideSegment(),
+                                                                      leftEdge.spec().section }];
+    if(   cached.radioVersion       == side.radioVersion()
+       && cached.shadowSize         == shadowSize
+       && cached.bottom             == leftEdge .bottom().z()
+       && cached.top                == rightEdge.top   ().z()
+       && cached.floorHeight        == visFloor  .heightSmoothed()
+       && cached.ceilingHeight      == visCeiling.heightSmoothed()
+       && cached.floorCastsShadow   == visFloor  .castsShadow()
+       && cached.ceilingCastsShadow == visCeiling.castsShadow())
+    {
+        return cached;
+    }
+
+    cached.radioVersion       = side.radioVersion();
+    cached.shadowSize         = shadowSize;
+    cached.bottom             = leftEdge .bottom().z();
+    cached.top                = rightEdge.top   ().z();
+    cached.floorHeight        = visFloor  .heightSmoothed();
+    cached.ceilingHeight      = visCeiling.heightSmoothed();
+    cached.floorCastsShadow   = visFloor  .castsShadow();
+    cached.ceilingCastsShadow = visCeiling.castsShadow();
+
+    for(dint i = TopShadow; i <= RightShadow; ++i)
+    {
+        cached.receives[i] = projectWallShadow(leftEdge, rightEdge, WallShadow(i), shadowSize,
+                                               cached.projected[i]);
+    }
+    return cached;
+}
+
 static void drawWallShadow(Vector3f const *posCoords, WallEdge const &leftEdge, WallEdge const &rightEdge,
     dfloat shadowDark, ProjectedShadowData const &tp)
 {
@@ -895,32 +981,32 @@ void Rend_DrawWallRadio(WallEdge const &leftEdge, WallEdge const &rightEdge, dfl
         rightEdge.top   ().origin()
     };
 
-    ProjectedShadowData projected;
+    CachedWallShadows const &shadows = projectWallShadows(leftEdge, rightEdge, shadowSize);
 
-    if(projectWallShadow(leftEdge, rightEdge, TopShadow, shadowSize, projected))
+    if(shadows.receives[TopShadow])
     {
         drawWallShadow(posCoords, leftEdge, rightEdge, shadowDark,
-                       projected);
+                       shadows.projected[TopShadow]);
     }
 
-    if(projectWallShadow(leftEdge, rightEdge, BottomShadow, shadowSize, projected))
+    if(shadows.receives[BottomShadow])
     {
         drawWallShadow(posCoords, leftEdge, rightEdge, shadowDark,
-                       projected);
+                       shadows.projected[BottomShadow]);
     }
 
-    if(projectWallShadow(leftEdge, rightEdge, LeftShadow, shadowSize, projected))
+    if(shadows.receives[LeftShadow])
     {
         drawWallShadow(posCoords, leftEdge, rightEdge,
                        shadowDark * de::cubed(wallSideOpenness(leftEdge, rightEdge, false/*left edge*/) * .8f),
-                       projected);
+                       shadows.projected[LeftShadow]);
     }
 
-    if(projectWallShadow(leftEdge, rightEdge, RightShadow, shadowSize, projected))
+    if(shadows.receives[RightShadow])
     {
         drawWallShadow(posCoords, leftEdge, rightEdge,
                        shadowDark * de::cubed(wallSideOpenness(leftEdge, rightEdge, true/*right edge*/) * .8f),
-                       projected);
+                       shadows.projected[RightShadow]);
     }
 }
 
@@ -1081,6 +1167,12 @@ void Rend_DrawFlatRadio(ConvexSubspace const &subspace)
     });
 }
 
+void Rend_RadioClearCache()
+{
+    wallShadowCache.clear();
+    ShadowEdge::clearCache();
+}
+
 void Rend_RadioRegister()
 {
     C_VAR_INT  ("rend-fakeradio",               &::rendFakeRadio,       0, 0, 2);
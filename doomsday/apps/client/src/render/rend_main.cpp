@@ -84,6 +84,7 @@
 //#include "ui/editors/edit_bias.h"
 
 #include "sys_system.h"
+#include "dd_def.h"
 #include "dd_main.h"
 #include "clientapp.h"
 #include "network/net_main.h"
@@ -100,6 +101,8 @@
 #include <de/vector1.h>
 #include <de/GLInfo>
 #include <de/GLState>
+#include <de/TaskPool>
+#include <de/Time>
 #include <QtAlgorithms>
 #include <QBitArray>
 #include <cmath>
@@ -158,6 +161,8 @@ D_CMD(LowRes);
 D_CMD(MipMap);
 D_CMD(TexReset);
 D_CMD(CubeShot);
+D_CMD(ProfileFrontEnd);
+D_CMD(ProfileClipper);
 
 #if 0
 dint useBias;  ///< Shadow Bias enabled? cvar
@@ -241,6 +246,7 @@ struct FixedView
 static std::unique_ptr<FixedView> fixedView;
 
 dbyte freezeRLs;
+static dbyte frontEndOnly;  ///< Prepare geometry but draw nothing (cvar).
 dint devNoCulling;  ///< @c 1= disabled (cvar).
 dint devRendSkyMode;
 dbyte devRendSkyAlways;
@@ -329,6 +335,52 @@ static ConvexSubspace *curSubspace;   ///< Subspace currently being drawn.
 static Vector3f curSectorLightColor;
 static dfloat curSectorLightLevel;
 static bool firstSubspace;            ///< No range checking for the first one.
+static QVector<ConvexSubspace *> visibleSubspaces;  ///< In traversal order.
+
+/// Number of planes per task when building plane geometries concurrently.
+static dint const FLAT_BATCH_SIZE = 256;
+
+/**
+ * View-dependent state of a lumobj for projecting it onto surfaces. Prepared once
+ * per frame rather than for each surface the lumobj is in contact with.
+ */
+struct FrameLumobj
+{
+    Vector3d center;       ///< Origin, including the Z offset.
+    dfloat attenuation;    ///< Due to distance from the viewer.
+    dbyte preparedLightmaps;  ///< Bits (1 << Lumobj::LightmapSemantic).
+    DGLuint lightmaps[3];
+};
+static QVector<FrameLumobj> frameLumobjs;  ///< Indexed by lumobj index in the map.
+
+/// Number of lumobjs per task when preparing them concurrently.
+static dint const LUMOBJ_BATCH_SIZE = 128;
+
+static bool profilingFrontEnd;
+static RendFrontEndStats frontEndStats;
+
+namespace {
+
+/**
+ * Adds the time spent in a front end stage to the statistics, if profiling.
+ */
+struct StageTimer
+{
+    ddouble *total;
+    ddouble startedAt;
+
+    StageTimer(ddouble &stageTotal)
+        : total(profilingFrontEnd? &stageTotal : nullptr)
+        , startedAt(total? ddouble(TimeSpan::sinceStartOfProcess()) : 0)
+    {}
+
+    ~StageTimer()
+    {
+        if (total) *total += ddouble(TimeSpan::sinceStartOfProcess()) - startedAt;
+    }
+};
+
+} // namespace
 
 // State lookup (for speed):
 static MaterialVariantSpec const *lookupMapSurfaceMaterialSpec = nullptr;
@@ -968,6 +1020,8 @@ static void lightWallOrFlatGeometry(Geometry &verts, duint numVertices, Vector3f
     MapElement &mapElement, dint /*geomGroup*/, Matrix3f const &/*surfaceTangents*/,
     Vector3f const &color, Vector3f const *color2, dfloat glowing, dfloat const luminosityDeltas[2])
 {
+    StageTimer const timer(frontEndStats.lightingTime);
+
     bool const haveWall = is<LineSideSegment>(mapElement);
     //auto &subsec = ::curSubspace->subsector().as<world::ClientSubsector>();
 
@@ -2194,6 +2248,42 @@ static DGLuint prepareLightmap(ClientTexture *tex = nullptr)
     return GL_PrepareLSTexture(LST_DYNAMIC);
 }
 
+/**
+ * Prepares the per-frame projection state of all lumobjs in the map. The lightmap
+ * textures are prepared later when first needed, as that must be done in the main
+ * thread.
+ */
+static void prepareFrameLumobjs(Map &map)
+{
+    frameLumobjs.resize(map.lumobjCount());
+    FrameLumobj *frames = frameLumobjs.data();
+
+    TaskPool::parallelFor(map.lumobjCount(), [&map, frames] (int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            Lumobj const &lum = map.lumobj(i);
+            FrameLumobj &frame = frames[i];
+
+            frame.center            = lum.origin();
+            frame.center.z         += lum.zOffset();
+            frame.attenuation       = lum.attenuation(R_ViewerLumobjDistance(i));
+            frame.preparedLightmaps = 0;
+        }
+    }, LUMOBJ_BATCH_SIZE);
+}
+
+static DGLuint frameLumobjLightmap(Lumobj const &lum, Lumobj::LightmapSemantic semantic)
+{
+    FrameLumobj &frame = frameLumobjs[lum.indexInMap()];
+    if (!(frame.preparedLightmaps & (1 << semantic)))
+    {
+        frame.lightmaps[semantic] = prepareLightmap(lum.lightmap(semantic));
+        frame.preparedLightmaps |= 1 << semantic;
+    }
+    return frame.lightmaps[semantic];
+}
+
 static bool projectDynlight(Vector3d const &topLeft, Vector3d const &bottomRight,
     Lumobj const &lum, Surface const &surface, dfloat blendFactor,
     ProjectedTextureData &projected)
@@ -2205,18 +2295,29 @@ static bool projectDynlight(Vector3d const &topLeft, Vector3d const &bottomRight
     if (R_ViewerLumobjIsHidden(lum.indexInMap()))
         return false;
 
-    // No lightmap texture?
-    DGLuint tex = prepareLightmap(lum.lightmap(lightmapForSurface(surface)));
-    if (!tex) return false;
-
-    Vector3d lumCenter = lum.origin();
-    lumCenter.z += lum.zOffset();
+    DENG2_ASSERT(lum.indexInMap() < frameLumobjs.size());
+    FrameLumobj const &frame = frameLumobjs.at(lum.indexInMap());
+    Vector3d const &lumCenter = frame.center;
+
+    // Too far from the bounds of the quad? The projected square can reach a bit
+    // further than the radius at its corners.
+    Vector3d const boundsMin = topLeft.min(bottomRight);
+    Vector3d const boundsMax = topLeft.max(bottomRight);
+    Vector3d const nearest(de::clamp(boundsMin.x, lumCenter.x, boundsMax.x),
+                           de::clamp(boundsMin.y, lumCenter.y, boundsMax.y),
+                           de::clamp(boundsMin.z, lumCenter.z, boundsMax.z));
+    if ((lumCenter - nearest).lengthSquared() > 2.25 * de::squared(lum.radius()))
+        return false;
 
     // On the right side?
     Vector3d topLeftToLum = topLeft - lumCenter;
     if (topLeftToLum.dot(surface.tangentMatrix().column(2)) > 0.f)
         return false;
 
+    // No lightmap texture?
+    DGLuint tex = frameLumobjLightmap(lum, lightmapForSurface(surface));
+    if (!tex) return false;
+
     // Calculate 3D distance between surface and lumobj.
     Vector3d pointOnPlane = R_ClosestPointOnPlane(surface.tangentMatrix().column(2)/*normal*/,
                                                   topLeft, lumCenter);
@@ -2229,7 +2330,7 @@ static bool projectDynlight(Vector3d const &topLeft, Vector3d const &bottomRight
     dfloat luma = 1.5f - 1.5f * distToLum / lum.radius();
 
     // Fade out as distance from viewer increases.
-    luma *= lum.attenuation(R_ViewerLumobjDistance(lum.indexInMap()));
+    luma *= frame.attenuation;
 
     // Would this be seen?
     if (luma * blendFactor < OMNILIGHT_SURFACE_LUMINOSITY_ATTRIBUTION_MIN)
@@ -2394,6 +2495,8 @@ static void projectDynamics(Surface const &surface, dfloat glowStrength,
     if (levelFullBright) return;
     if (glowStrength >= 1) return;
 
+    StageTimer const timer(frontEndStats.dynamicsTime);
+
     // lights?
     if (!noLights)
     {
@@ -2815,10 +2918,12 @@ static void writeWall(WallEdge const &leftEdge, WallEdge const &rightEdge,
 
     // Draw this wall.
     bool const wroteOpaque = renderWorldPoly(posCoords, 4, parm, matAnimator);
+    frontEndStats.wallCount++;
 
     // Draw FakeRadio for this wall?
     if (wroteOpaque && !skyMasked && !(parm.glowing > 0))
     {
+        StageTimer const timer(frontEndStats.shadowTime);
         Rend_DrawWallRadio(leftEdge, rightEdge, ::curSectorLightLevel);
     }
 
@@ -2836,33 +2941,39 @@ static void writeWall(WallEdge const &leftEdge, WallEdge const &rightEdge,
 }
 
 /**
- * Prepare a trifan geometry according to the edges of the current subspace.
- * If a fan base HEdge has been chosen it will be used as the center of the
- * trifan, else the mid point of this leaf will be used instead.
+ * Returns the number of vertices in the trifan geometry of a subspace plane.
+ */
+static duint subspacePlaneVertexCount(ConvexSubspace const &subspace)
+{
+    return subspace.poly().hedgeCount() + (!subspace.fanBase()? 2 : 0);
+}
+
+/**
+ * Prepare a trifan geometry according to the edges of a subspace. If a fan base
+ * HEdge has been chosen it will be used as the center of the trifan, else the
+ * mid point of this leaf will be used instead.
+ *
+ * The subspace's fan base must already have been chosen, as this may be called
+ * concurrently for many subspaces.
  *
+ * @param subspace   Subspace to build the plane geometry for.
  * @param direction  Vertex winding direction.
  * @param height     Z map space height coordinate to be set for each vertex.
- * @param verts      Built position coordinates are written here. It is the
- *                   responsibility of the caller to release this storage with
- *                   @ref R_FreeRendVertices() when done.
- *
- * @return  Number of built vertices.
+ * @param verts      Built position coordinates are written here. There must be room
+ *                   for subspacePlaneVertexCount() coordinates.
  */
-static duint buildSubspacePlaneGeometry(ClockDirection direction, coord_t height,
-    Vector3f **verts)
+static void buildSubspacePlaneGeometry(ConvexSubspace const &subspace, ClockDirection direction,
+    coord_t height, Vector3f *verts)
 {
     DENG2_ASSERT(verts);
 
-    Face const &poly       = curSubspace->poly();
-    HEdge *fanBase         = curSubspace->fanBase();
-    duint const totalVerts = poly.hedgeCount() + (!fanBase? 2 : 0);
-
-    *verts = R_AllocRendVertices(totalVerts);
+    Face const &poly = subspace.poly();
+    HEdge *fanBase   = subspace.fanBase();
 
     duint n = 0;
     if (!fanBase)
     {
-        (*verts)[n] = Vector3f(poly.center(), height);
+        verts[n] = Vector3f(poly.center(), height);
         n++;
     }
 
@@ -2871,20 +2982,23 @@ static duint buildSubspacePlaneGeometry(ClockDirection direction, coord_t height
     HEdge *node = baseNode;
     do
     {
-        (*verts)[n] = Vector3f(node->origin(), height);
+        verts[n] = Vector3f(node->origin(), height);
         n++;
     } while ((node = &node->neighbor(direction)) != baseNode);
 
     // The last vertex is always equal to the first.
     if (!fanBase)
     {
-        (*verts)[n] = Vector3f(poly.hedge()->origin(), height);
+        verts[n] = Vector3f(poly.hedge()->origin(), height);
     }
-
-    return totalVerts;
 }
 
-static void writeSubspacePlane(Plane &plane)
+/**
+ * @param plane      Plane of the current subspace.
+ * @param posCoords  Trifan geometry of the plane (see buildSubspacePlaneGeometry()).
+ * @param vertCount  Number of vertices in @a posCoords.
+ */
+static void writeSubspacePlane(Plane &plane, Vector3f const *posCoords, duint vertCount)
 {
     Face const &poly       = curSubspace->poly();
     Surface const &surface = plane.surface();
@@ -3001,13 +3115,9 @@ static void writeSubspacePlane(Plane &plane)
         curSectorLightLevel = plane.sector().lightLevel();
     }
 
-    // Allocate position coordinates.
-    Vector3f *posCoords;
-    duint vertCount = buildSubspacePlaneGeometry((plane.isSectorCeiling())? Anticlockwise : Clockwise,
-                                                 plane.heightSmoothed(), &posCoords);
-
     // Draw this section.
     renderWorldPoly(posCoords, vertCount, parm, matAnimator);
+    frontEndStats.flatCount++;
 
     if (&plane.sector() != &curSubspace->subsector().sector())
     {
@@ -3016,8 +3126,6 @@ static void writeSubspacePlane(Plane &plane)
         curSectorLightColor = color.toVector3f();
         curSectorLightLevel = color.w;
     }
-
-    R_FreeRendVertices(posCoords);
 }
 
 static void writeSkyMaskStrip(dint vertCount, Vector3f const *posCoords, Vector2f const *texCoords,
@@ -3492,19 +3600,68 @@ static void writeSubspaceWalls()
     });
 }
 
-static void writeSubspaceFlats()
+static void makeCurrent(ConvexSubspace &subspace);
+
+/**
+ * Writes the planes of all the subspaces found visible during BSP traversal. Planes
+ * do not occlude anything in the angle clipper, so they can be written as a separate
+ * pass after the traversal. The trifan geometries are built concurrently; the planes
+ * are then written in the order the subspaces were traversed.
+ */
+static void writeVisibleFlats()
 {
-    DENG2_ASSERT(::curSubspace);
-    auto &subsec = ::curSubspace->subsector().as<world::ClientSubsector>();
-    for (dint i = 0; i < subsec.visPlaneCount(); ++i)
+    struct PlaneJob
     {
-        // Skip planes facing away from the viewer.
-        Plane &plane = subsec.visPlane(i);
-        Vector3d const pointOnPlane(subsec.center(), plane.heightSmoothed());
-        if ((eyeOrigin - pointOnPlane).dot(plane.surface().normal()) < 0)
-            continue;
+        ConvexSubspace *subspace;
+        Plane *plane;
+        duint firstVertex;
+        duint vertexCount;
+    };
+    static QVector<PlaneJob> jobs;
+    static QVector<Vector3f> posCoords;
+
+    // Collect the planes facing the viewer.
+    jobs.clear();
+    duint totalVertices = 0;
+    for (ConvexSubspace *subspace : visibleSubspaces)
+    {
+        auto &subsec = subspace->subsector().as<world::ClientSubsector>();
+        for (dint i = 0; i < subsec.visPlaneCount(); ++i)
+        {
+            // Skip planes facing away from the viewer.
+            Plane &plane = subsec.visPlane(i);
+            Vector3d const pointOnPlane(subsec.center(), plane.heightSmoothed());
+            if ((eyeOrigin - pointOnPlane).dot(plane.surface().normal()) < 0)
+                continue;
+
+            duint const count = subspacePlaneVertexCount(*subspace);
+            jobs.append(PlaneJob{ subspace, &plane, totalVertices, count });
+            totalVertices += count;
+        }
+    }
+    if (jobs.isEmpty()) return;
 
-        writeSubspacePlane(plane);
+    if (posCoords.size() < dint(totalVertices))
+    {
+        posCoords.resize(totalVertices);
+    }
+    Vector3f *coords = posCoords.data();
+
+    TaskPool::parallelFor(jobs.size(), [coords] (int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            PlaneJob const &job = jobs.at(i);
+            buildSubspacePlaneGeometry(*job.subspace,
+                                       job.plane->isSectorCeiling()? Anticlockwise : Clockwise,
+                                       job.plane->heightSmoothed(), coords + job.firstVertex);
+        }
+    }, FLAT_BATCH_SIZE);
+
+    for (PlaneJob const &job : jobs)
+    {
+        makeCurrent(*job.subspace);
+        writeSubspacePlane(*job.plane, coords + job.firstVertex, job.vertexCount);
     }
 }
 
@@ -3761,6 +3918,8 @@ static void drawCurrentSubspace()
 
     Sector &sector = ::curSubspace->sector();
 
+    frontEndStats.subspaceCount++;
+
     // Mark the leaf as visible for this frame.
     R_ViewerSubspaceMarkVisible(*::curSubspace);
 
@@ -3769,18 +3928,24 @@ static void drawCurrentSubspace()
     // Perform contact spreading for this map region.
     sector.map().spreadAllContacts(::curSubspace->poly().bounds());
 
-    Rend_DrawFlatRadio(*::curSubspace);
+    {
+        StageTimer const timer(frontEndStats.shadowTime);
+        Rend_DrawFlatRadio(*::curSubspace);
+    }
 
     // Before clip testing lumobjs (for halos), range-occlude the back facing edges.
     // After testing, range-occlude the front facing edges. Done before drawing wall
     // sections so that opening occlusions cut out unnecessary oranges.
+    {
+        StageTimer const timer(frontEndStats.clippingTime);
 
-    occludeSubspace(false /* back facing */);
-    clipSubspaceLumobjs();
-    occludeSubspace(true /* front facing */);
+        occludeSubspace(false /* back facing */);
+        clipSubspaceLumobjs();
+        occludeSubspace(true /* front facing */);
 
-    clipSubspaceFrontFacingWalls();
-    clipSubspaceLumobjsBySight();
+        clipSubspaceFrontFacingWalls();
+        clipSubspaceLumobjsBySight();
+    }
 
     // Mark generators in the sector visible.
     if (::useParticles)
@@ -3800,11 +3965,21 @@ static void drawCurrentSubspace()
     //
     // Must be done AFTER the lumobjs have been clipped as this affects the projection
     // of halos.
-    projectSubspaceSprites();
+    {
+        StageTimer const timer(frontEndStats.spriteTime);
+        projectSubspaceSprites();
+    }
+    {
+        StageTimer const timer(frontEndStats.skyMaskTime);
+        writeSubspaceSkyMask();
+    }
+    {
+        StageTimer const timer(frontEndStats.wallTime);
+        writeSubspaceWalls();
+    }
 
-    writeSubspaceSkyMask();
-    writeSubspaceWalls();
-    writeSubspaceFlats();
+    // The planes are written after the traversal.
+    visibleSubspaces.append(::curSubspace);
 }
 
 /**
@@ -4519,6 +4694,18 @@ static void drawMasked()
     {
         bool primaryHaloDrawn = false;
 
+        // Prepare the vertices of all the models at once, so that the work can be
+        // shared by multiple threads.
+        {
+            static QVector<vissprite_t const *> models; // Reused between frames.
+            models.clear();
+            for (vissprite_t const *spr = ::visSprSortedHead.next; spr != &::visSprSortedHead; spr = spr->next)
+            {
+                if (spr->type == VSPR_MODEL) models << spr;
+            }
+            Rend_PrepareModels(models);
+        }
+
         // Draw all vissprites back to front.
         // Sprites look better with Z buffer writes turned off.
         for (vissprite_t *spr = ::visSprSortedHead.next; spr != &::visSprSortedHead; spr = spr->next)
@@ -4783,51 +4970,100 @@ static void drawAllLists(Map &map)
     DENG2_ASSERT(!Sys_GLCheckError());
 }
 
-void Rend_RenderMap(Map &map)
+void Rend_PrepareMap(Map &map)
 {
-    //GL_SetMultisample(true);
+    // Prepare for rendering.
+    ClientApp::renderSystem().beginFrame();
+    prepareFrameLumobjs(map);
 
-    // Setup the modelview matrix.
-    Rend_ModelViewMatrix();
-
-    if (!freezeRLs)
     {
-        // Prepare for rendering.
-        ClientApp::renderSystem().beginFrame();
+        StageTimer const timer(frontEndStats.decorationTime);
 
         // Make vissprites of all the visible decorations.
         generateDecorationFlares(map);
+    }
 
-        viewdata_t const *viewData = &viewPlayer->viewport();
-        eyeOrigin = viewData->current.origin;
+    viewdata_t const *viewData = &viewPlayer->viewport();
+    eyeOrigin = viewData->current.origin;
 
-        // Add the backside clipping range (if vpitch allows).
-        if (vpitch <= 90 - yfov / 2 && vpitch >= -90 + yfov / 2)
-        {
-            AngleClipper &clipper = ClientApp::renderSystem().angleClipper();
+    // Add the backside clipping range (if vpitch allows).
+    if (vpitch <= 90 - yfov / 2 && vpitch >= -90 + yfov / 2)
+    {
+        AngleClipper &clipper = ClientApp::renderSystem().angleClipper();
 
-            dfloat a = de::abs(vpitch) / (90 - yfov / 2);
-            binangle_t startAngle = binangle_t(BANG_45 * Rend_FieldOfView() / 90) * (1 + a);
-            binangle_t angLen = BANG_180 - startAngle;
+        dfloat a = de::abs(vpitch) / (90 - yfov / 2);
+        binangle_t startAngle = binangle_t(BANG_45 * Rend_FieldOfView() / 90) * (1 + a);
+        binangle_t angLen = BANG_180 - startAngle;
 
-            binangle_t viewside = (viewData->current.angle() >> (32 - BAMS_BITS)) + startAngle;
-            clipper.safeAddRange(viewside, viewside + angLen);
-            clipper.safeAddRange(viewside + angLen, viewside + 2 * angLen);
-        }
+        binangle_t viewside = (viewData->current.angle() >> (32 - BAMS_BITS)) + startAngle;
+        clipper.safeAddRange(viewside, viewside + angLen);
+        clipper.safeAddRange(viewside + angLen, viewside + 2 * angLen);
+    }
 
-        // The viewside line for the depth cue.
-        viewsidex = -viewData->viewSin;
-        viewsidey = viewData->viewCos;
+    // The viewside line for the depth cue.
+    viewsidex = -viewData->viewSin;
+    viewsidey = viewData->viewCos;
 
-        // We don't want BSP clip checking for the first subspace.
-        firstSubspace = true;
+    // We don't want BSP clip checking for the first subspace.
+    firstSubspace = true;
 
-        // No current subspace as of yet.
-        curSubspace = nullptr;
+    // No current subspace as of yet.
+    curSubspace = nullptr;
+    visibleSubspaces.clear();
 
-        // Draw the world!
+    // Draw the world!
+    {
+        StageTimer const timer(frontEndStats.traversalTime);
         traverseBspTreeAndDrawSubspaces(&map.bspTree());
     }
+    {
+        StageTimer const timer(frontEndStats.flatTime);
+        writeVisibleFlats();
+    }
+
+    if (profilingFrontEnd)
+    {
+        frontEndStats.frames++;
+        frontEndStats.visSpriteCount += dint(visSpriteP - visSprites);
+        frontEndStats.vertexCount    += ClientApp::renderSystem().buffer().vertexCount();
+
+        DrawLists::FoundLists lists;
+        for (dint group = UnlitGeom; group <= ShineGeom; ++group)
+        {
+            frontEndStats.drawListCount +=
+                ClientApp::renderSystem().drawLists().findAll(GeomGroup(group), lists);
+        }
+    }
+}
+
+void Rend_SetFrontEndProfiling(bool enabled)
+{
+    profilingFrontEnd = enabled;
+    ClientApp::renderSystem().drawLists().setCollectStatistics(enabled);
+    if (enabled)
+    {
+        frontEndStats = RendFrontEndStats();
+    }
+}
+
+RendFrontEndStats const &Rend_FrontEndStats()
+{
+    return frontEndStats;
+}
+
+void Rend_RenderMap(Map &map)
+{
+    //GL_SetMultisample(true);
+
+    // Setup the modelview matrix.
+    Rend_ModelViewMatrix();
+
+    if (!freezeRLs)
+    {
+        Rend_PrepareMap(map);
+    }
+    if (frontEndOnly) return;
+
     drawAllLists(map);
 
     // Draw various debugging displays:
@@ -6234,6 +6470,153 @@ D_CMD(TexReset)
     return true;
 }
 
+/**
+ * Prepares @a frames frames of the current map without drawing them, turning the
+ * console player's view a full circle.
+ *
+ * @return  @c false if there is no map or the console player is not in the game.
+ */
+static bool prepareTurningFrames(dint frames)
+{
+    if (!App_World().hasMap())
+    {
+        LOG_SCR_ERROR("No map is currently loaded");
+        return false;
+    }
+
+    player_t *player = DD_Player(consolePlayer);
+    if (!player->publicData().inGame || !player->publicData().mo)
+    {
+        LOG_SCR_ERROR("Console player is not in the game");
+        return false;
+    }
+
+    Map &map = App_World().map();
+    viewdata_t *viewData = &player->viewport();
+    viewdata_t const oldViewData = *viewData;
+
+    // Hide the player's own mobj, as when rendering the player view.
+    mobj_t *mob = player->publicData().mo;
+    dint const oldFlags = mob->ddFlags;
+    if (!(player->publicData().flags & DDPF_CHASECAM))
+    {
+        mob->ddFlags |= DDMF_DONTDRAW;
+    }
+
+    // Material textures get prepared along the way.
+    ClientWindow::main().glActivate();
+
+    for (dint i = 0; i < frames; ++i)
+    {
+        angle_t const yaw = oldViewData.current.angleWithoutHeadTracking()
+                          + angle_t(ddouble(i) / frames * ANGLE_MAX);
+        viewData->current.setAngle(yaw);
+        viewData->viewSin = FIX2FLT(finesine  [yaw >> ANGLETOFINESHIFT]);
+        viewData->viewCos = FIX2FLT(fineCosine[yaw >> ANGLETOFINESHIFT]);
+
+        R_SetupFrame(player);
+        Rend_GetModelViewMatrix(consolePlayer);  // Updates the view angles and origin.
+        Rend_PrepareMap(map);
+        R_IncrementFrameCount();
+    }
+
+    ClientWindow::main().glDone();
+
+    mob->ddFlags = oldFlags;
+    *viewData = oldViewData;
+    return true;
+}
+
+/**
+ * Prepares the world geometry for a number of frames without drawing anything, while
+ * turning the console player's view around a full circle, and prints the time spent
+ * in each stage of the front end.
+ */
+D_CMD(ProfileFrontEnd)
+{
+    DENG2_UNUSED(src);
+
+    dint const frames = (argc > 1? String(argv[1]).toInt() : 360);
+    if (frames < 1)
+    {
+        LOG_SCR_ERROR("Invalid number of frames %i") << frames;
+        return false;
+    }
+
+    Rend_SetFrontEndProfiling(true);
+    bool const prepared = prepareTurningFrames(frames);
+    Rend_SetFrontEndProfiling(false);
+    if (!prepared) return false;
+
+    RendFrontEndStats const &st = Rend_FrontEndStats();
+    auto const perFrame = [&st] (ddouble seconds) { return seconds * 1000 / st.frames; };
+
+    LOG_SCR_MSG(_E(b) "Render front end: %i frames in %.1f ms (%.3f ms per frame)")
+            << st.frames << (st.decorationTime + st.traversalTime + st.flatTime) * 1000
+            << perFrame(st.decorationTime + st.traversalTime + st.flatTime);
+    LOG_SCR_MSG("  Decorations: %.3f ms") << perFrame(st.decorationTime);
+    LOG_SCR_MSG("  BSP traversal: %.3f ms, %i subspaces") << perFrame(st.traversalTime) << st.subspaceCount / st.frames;
+    LOG_SCR_MSG("    Clipping: %.3f ms") << perFrame(st.clippingTime);
+    LOG_SCR_MSG("    Sprites: %.3f ms, %i vissprites") << perFrame(st.spriteTime) << st.visSpriteCount / st.frames;
+    LOG_SCR_MSG("    Sky mask: %.3f ms") << perFrame(st.skyMaskTime);
+    LOG_SCR_MSG("    Walls: %.3f ms, %i sections") << perFrame(st.wallTime) << st.wallCount / st.frames;
+    LOG_SCR_MSG("    FakeRadio: %.3f ms") << perFrame(st.shadowTime);
+    LOG_SCR_MSG("  Flats: %.3f ms, %i planes") << perFrame(st.flatTime) << st.flatCount / st.frames;
+    LOG_SCR_MSG("  Lighting (walls and flats): %.3f ms") << perFrame(st.lightingTime);
+    LOG_SCR_MSG("  Dynamics (walls and flats): %.3f ms") << perFrame(st.dynamicsTime);
+    LOG_SCR_MSG("  Draw lists: %i, vertices: %i")
+            << st.drawListCount / st.frames << st.vertexCount / st.frames;
+
+    DrawLists::Statistics const &lookups = ClientApp::renderSystem().drawLists().statistics();
+    LOG_SCR_MSG("  Draw list lookups: %i in %.3f ms, %.2f lists compared per lookup, %i created")
+            << lookups.findCount / st.frames << perFrame(lookups.findTime)
+            << (lookups.findCount? ddouble(lookups.probeCount) / lookups.findCount : 0.0)
+            << lookups.createdCount;
+    return true;
+}
+
+/**
+ * Benchmarks the angle clipper. The clipper calls made while preparing frames of
+ * the current map (as in "rendprofile") are recorded, and then replayed against
+ * a separate clipper.
+ */
+D_CMD(ProfileClipper)
+{
+    DENG2_UNUSED(src);
+
+    dint const frames     = (argc > 1? String(argv[1]).toInt() : 360);
+    dint const iterations = (argc > 2? String(argv[2]).toInt() : 10);
+    if (frames < 1 || iterations < 1)
+    {
+        LOG_SCR_ERROR("Invalid number of frames %i or iterations %i") << frames << iterations;
+        return false;
+    }
+
+    // Record the traversals.
+    AngleClipper::Recording recording;
+    AngleClipper &clipper = ClientApp::renderSystem().angleClipper();
+    clipper.setRecording(&recording);
+    bool const prepared = prepareTurningFrames(frames);
+    clipper.setRecording(nullptr);
+    if (!prepared) return false;
+
+    // The view was only turned, so the eye origin is the same as when recording.
+    AngleClipper replayClipper;
+    dint visibleCount = 0;
+    Time const startedAt;
+    for (dint i = 0; i < iterations; ++i)
+    {
+        visibleCount = replayClipper.replay(recording);
+    }
+    TimeSpan const elapsed = startedAt.since();
+
+    LOG_SCR_MSG(_E(b) "Angle clipper: %i frames, %i calls (%i found visible), %i iterations")
+            << frames << recording.calls.size() << visibleCount << iterations;
+    LOG_SCR_MSG("  Replay: %.3f ms per frame")
+            << ddouble(elapsed) * 1000 / (ddouble(frames) * iterations);
+    return true;
+}
+
 static void detailFactorChanged()
 {
     App_Resources().releaseGLTexturesByScheme("Details");
@@ -6358,6 +6741,7 @@ void Rend_Register()
     C_VAR_FLOAT("rend-dev-blockmap-debug-size", &bmapDebugSize, CVF_NO_ARCHIVE, .1f, 100);
     C_VAR_INT("rend-dev-cull-leafs", &devNoCulling, CVF_NO_ARCHIVE, 0, 1);
     C_VAR_BYTE("rend-dev-freeze", &freezeRLs, CVF_NO_ARCHIVE, 0, 1);
+    C_VAR_BYTE("rend-dev-frontend-only", &frontEndOnly, CVF_NO_ARCHIVE, 0, 1);
     C_VAR_BYTE("rend-dev-generator-show-indices", &devDrawGenerators, CVF_NO_ARCHIVE, 0, 1);
     C_VAR_BYTE("rend-dev-light-mod", &devLightModRange, CVF_NO_ARCHIVE, 0, 1);
     C_VAR_BYTE("rend-dev-lums", &devDrawLums, CVF_NO_ARCHIVE, 0, 1);
@@ -6377,6 +6761,11 @@ void Rend_Register()
     C_CMD("rendedit", "", OpenRendererAppearanceEditor);
     C_CMD("modeledit", "", OpenModelAssetEditor);
     C_CMD("cubeshot", "i", CubeShot);
+    C_CMD("rendprofile", "", ProfileFrontEnd);
+    C_CMD("rendprofile", "i", ProfileFrontEnd);
+    C_CMD("clipprofile", "", ProfileClipper);
+    C_CMD("clipprofile", "i", ProfileClipper);
+    C_CMD("clipprofile", "ii", ProfileClipper);
 
     C_CMD_FLAGS("lowres", "", LowRes, CMDF_NO_DEDICATED);
     C_CMD_FLAGS("mipmap", "i", MipMap, CMDF_NO_DEDICATED);
@@ -42,14 +42,18 @@
 #include "ClientTexture"
 #include "ClientMaterial"
 
+#include <doomsday/console/cmd.h>
 #include <doomsday/console/var.h>
 #include <doomsday/world/Materials>
 #include <de/Log>
 #include <de/ArrayValue>
 #include <de/GLInfo>
 #include <de/binangle.h>
-#include <de/memory.h>
 #include <de/concurrency.h>
+#include <de/TaskPool>
+#include <de/Time>
+#include <QHash>
+#include <QSet>
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
@@ -95,22 +99,77 @@ struct array_t
 #define MAX_ARRAYS (2 + MAX_TEX_UNITS)
 static array_t arrays[MAX_ARRAYS];
 
-// The global vertex render buffer.
-static Vector3f *modelPosCoords;
-static Vector3f *modelNormCoords;
-static Vector4ub *modelColorCoords;
-static Vector2f *modelTexCoords;
-
-// Global variables for ease of use. (Egads!)
-static Vector3f modelCenter;
-static FrameModelLOD *activeLod;
-
 static uint vertexBufferMax; ///< Maximum number of vertices we'll be required to render per submodel.
-static uint vertexBufferSize; ///< Current number of vertices supported by the render buffer.
 #ifdef DENG_DEBUG
 static bool announcedVertexBufferMaxBreach; ///< @c true if an attempt has been made to expand beyond our capability.
 #endif
 
+/**
+ * Vector light prepared for lighting the vertices of a single submodel.
+ */
+struct ModelVectorLight
+{
+    Vector3f direction; ///< In model space.
+    Vector3f color;
+    dfloat offset;
+    dfloat lightSide;
+    dfloat darkSide;
+    dint accumIndex;    ///< 0= affected by ambient, 1= extra.
+};
+
+/**
+ * Submodel prepared for drawing. The parameters are determined on the main thread,
+ * after which the vertices can be prepared on any thread as they only depend on
+ * the data stored here and the (read-only) model frames.
+ */
+struct PreparedSubmodel
+{
+    enum Lighting { FullBright, Uniform, VertexLit };
+
+    vissprite_t const *spr = nullptr;
+    duint number = 0;
+
+    FrameModelDef const *mfNext = nullptr;
+    FrameModelFrame const *frame = nullptr;
+    FrameModelFrame const *nextFrame = nullptr;
+    FrameModelLOD const *lod = nullptr; ///< @c nullptr= all vertices are used.
+    dfloat inter = 0;
+    dint numVerts = 0;
+    bool mirrored = false;
+
+    dfloat alpha = 0;
+    blendmode_t blending = BM_NORMAL;
+    dint skin = 0;
+
+    Lighting lighting = Uniform;
+    Vector4f ambient;
+    QVector<ModelVectorLight> lights;
+
+    dfloat shininess = 0;
+    Vector4f shinyColor;
+    dfloat normYaw = 0;
+    dfloat normPitch = 0;
+    dfloat shinyAng = 0;
+    dfloat shinyPnt = 0;
+    dfloat shinyReact = 0;
+
+    // Prepared vertices:
+    QVector<Vector3f> posCoords;
+    QVector<Vector3f> normCoords;
+    QVector<Vector4ub> colorCoords;
+    QVector<Vector2f> texCoords;
+};
+
+/// Submodels prepared ahead of drawing. The elements are reused from frame to frame,
+/// so that the vertex buffers remain allocated.
+static QVector<PreparedSubmodel> preparedSubmodels;
+static dint preparedCount;
+
+/// Index of the first prepared submodel of each vissprite.
+static QHash<vissprite_t const *, dint> preparedModels;
+
+D_CMD(ProfileModels);
+
 /*static void modelAspectModChanged()
 {
     /// @todo Reload and resize all models.
@@ -129,18 +188,16 @@ void Rend_ModelRegister()
     C_VAR_FLOAT("rend-model-spin-speed",     &modelSpinSpeed,       CVF_NO_MAX | CVF_NO_MIN, 0, 0);
     C_VAR_FLOAT("rend-model-shiny-strength", &modelShinyFactor,     0, 0, 10);
     C_VAR_FLOAT("rend-model-fov",            &weaponFixedFOV,       0, 0, 180);
+
+    C_CMD("modelprofile", "",  ProfileModels);
+    C_CMD("modelprofile", "i", ProfileModels);
 }
 
 void Rend_ModelInit()
 {
     if (inited) return; // Already been here.
 
-    modelPosCoords   = 0;
-    modelNormCoords  = 0;
-    modelColorCoords = 0;
-    modelTexCoords   = 0;
-
-    vertexBufferMax = vertexBufferSize = 0;
+    vertexBufferMax = 0;
 #ifdef DENG_DEBUG
     announcedVertexBufferMaxBreach = false;
 #endif
@@ -152,12 +209,11 @@ void Rend_ModelShutdown()
 {
     if (!inited) return;
 
-    M_Free(modelPosCoords); modelPosCoords = 0;
-    M_Free(modelNormCoords); modelNormCoords = 0;
-    M_Free(modelColorCoords); modelColorCoords = 0;
-    M_Free(modelTexCoords); modelTexCoords = 0;
+    preparedModels.clear();
+    preparedSubmodels.clear();
+    preparedCount = 0;
 
-    vertexBufferMax = vertexBufferSize = 0;
+    vertexBufferMax = 0;
 #ifdef DENG_DEBUG
     announcedVertexBufferMaxBreach = false;
 #endif
@@ -187,33 +243,12 @@ bool Rend_ModelExpandVertexBuffers(uint numVertices)
         return false;
     }
 
-    // Defer resizing of the render buffer until draw time as it may be repeatedly expanded.
+    // The prepared vertex buffers are resized at draw time, as the maximum may be
+    // repeatedly expanded.
     vertexBufferMax = numVertices;
     return true;
 }
 
-/// @return  @c true= Vertex buffer is large enough to handle @a numVertices.
-static bool resizeVertexBuffer(uint numVertices)
-{
-    // Mark the vertex buffer if a resize is necessary.
-    Rend_ModelExpandVertexBuffers(numVertices);
-
-    // Do we need to resize the buffers?
-    if (vertexBufferMax != vertexBufferSize)
-    {
-        /// @todo Align access to this memory along a 4-byte boundary?
-        modelPosCoords   =  (Vector3f *) M_Realloc(modelPosCoords,   sizeof(*modelPosCoords)   * vertexBufferMax);
-        modelNormCoords  =  (Vector3f *) M_Realloc(modelNormCoords,  sizeof(*modelNormCoords)  * vertexBufferMax);
-        modelColorCoords = (Vector4ub *) M_Realloc(modelColorCoords, sizeof(*modelColorCoords) * vertexBufferMax);
-        modelTexCoords   =  (Vector2f *) M_Realloc(modelTexCoords,   sizeof(*modelTexCoords)   * vertexBufferMax);
-
-        vertexBufferSize = vertexBufferMax;
-    }
-
-    // Is the buffer large enough?
-    return vertexBufferSize >= numVertices;
-}
-
 static void disableArrays(int vertices, int colors, int coords)
 {
     DENG_ASSERT_IN_MAIN_THREAD();
@@ -465,43 +500,62 @@ static void drawPrimitives(rendcmd_t mode,
     DGL_End();
 }
 
+/**
+ * Interpolate linearly between two arrays of coordinates. The arrays are treated
+ * as flat float arrays so that the compiler is able to vectorize the loop.
+ */
+static void lerpCoords(float inter, int count, Vector3f const *from, Vector3f const *to,
+    Vector3f *out)
+{
+    float const *a = &from->x;
+    float const *b = &to->x;
+    float *o       = &out->x;
+    float const invInter = 1.f - inter;
+
+    for (int i = 0; i < count * 3; ++i)
+    {
+        o[i] = b[i] * inter + a[i] * invInter;
+    }
+}
+
 /**
  * Interpolate linearly between two sets of vertices.
+ *
+ * All vertices are processed regardless of the active LOD; the vertices that are
+ * not used at the current detail level are simply never drawn. This is cheaper
+ * than testing each vertex individually.
  */
 static void Mod_LerpVertices(float inter, int count, FrameModelFrame const &from,
     FrameModelFrame const &to, Vector3f *posOut, Vector3f *normOut)
 {
     DENG2_ASSERT(&from.model == &to.model); // sanity check.
-    DENG2_ASSERT(!activeLod || &activeLod->model == &from.model); // sanity check.
-    DENG2_ASSERT(from.vertices.count() == to.vertices.count()); // sanity check.
-
-    FrameModelFrame::VertexBuf::const_iterator startIt = from.vertices.begin();
-    FrameModelFrame::VertexBuf::const_iterator endIt   = to.vertices.begin();
+    DENG2_ASSERT(from.positions.count() == to.positions.count()); // sanity check.
+    DENG2_ASSERT(count <= from.positions.count());
 
     if (&from == &to || de::fequal(inter, 0))
     {
-        for (int i = 0; i < count; ++i, startIt++, posOut++, normOut++)
-        {
-            if (!activeLod || activeLod->hasVertex(i))
-            {
-                *posOut  = startIt->pos;
-                *normOut = startIt->norm;
-            }
-        }
+        std::memcpy(posOut,  from.positions.constData(), sizeof(Vector3f) * count);
+        std::memcpy(normOut, from.normals  .constData(), sizeof(Vector3f) * count);
     }
     else
     {
-        for (int i = 0; i < count; ++i, startIt++, endIt++, posOut++, normOut++)
-        {
-            if (!activeLod || activeLod->hasVertex(i))
-            {
-                *posOut  = de::lerp(startIt->pos,  endIt->pos,  inter);
-                *normOut = de::lerp(startIt->norm, endIt->norm, inter);
-            }
-        }
+        lerpCoords(inter, count, from.positions.constData(), to.positions.constData(), posOut);
+        lerpCoords(inter, count, from.normals  .constData(), to.normals  .constData(), normOut);
     }
 }
 
+/**
+ * Determines which vertices are used at the detail level @a lod. Returns @c nullptr
+ * if all vertices are in use.
+ */
+static QBitArray const *lodVertexUsage(FrameModelLOD const *lod, int *stride, int *level)
+{
+    if (!lod) return nullptr;
+    *stride = lod->model.lodCount();
+    *level  = lod->level;
+    return &lod->model.lodVertexUsage();
+}
+
 static void Mod_MirrorCoords(dint count, Vector3f *coords, dint axis)
 {
     DENG2_ASSERT(coords);
@@ -538,47 +592,67 @@ static Vector3f rotateLightVector(VectorLightData const &vlight, dfloat yaw, dfl
 }
 
 /**
- * Calculate vertex lighting.
+ * Collect the vector lights affecting a submodel and transform them to model space.
+ * The light lists are only accessed on the main thread.
+ */
+static void collectModelLights(QVector<ModelVectorLight> &lights, duint lightListIdx,
+    duint maxLights, bool invert, dfloat rotateYaw, dfloat rotatePitch)
+{
+    DENG_ASSERT_IN_MAIN_THREAD();
+
+    lights.clear();
+    ClientApp::renderSystem().forAllVectorLights(lightListIdx, [&lights, &maxLights, &invert
+                                                  , &rotateYaw, &rotatePitch] (VectorLightData const &vlight)
+    {
+        ModelVectorLight ml;
+        // We must transform the light vector to model space.
+        ml.direction  = rotateLightVector(vlight, rotateYaw, rotatePitch, invert);
+        ml.color      = vlight.color;
+        ml.offset     = vlight.offset; // Shift a bit towards the light.
+        ml.lightSide  = vlight.lightSide;
+        ml.darkSide   = vlight.darkSide;
+        ml.accumIndex = vlight.affectedByAmbient? 0 : 1;
+        lights << ml;
+
+        // Time to stop?
+        return (maxLights && duint(lights.size()) == maxLights);
+    });
+}
+
+/**
+ * Calculate vertex lighting. The affecting lights have already been transformed to
+ * model space, so each vertex only needs to accumulate the contributions.
  */
 static void Mod_VertexColors(Vector4ub *out, dint count, Vector3f const *normCoords,
-    duint lightListIdx, duint maxLights, Vector4f const &ambient, bool invert,
-    dfloat rotateYaw, dfloat rotatePitch)
+    QVector<ModelVectorLight> const &lights, Vector4f const &ambient, FrameModelLOD const *lod)
 {
     Vector4f const saturated(1, 1, 1, 1);
 
+    ModelVectorLight const *lightsBegin = lights.constData();
+    ModelVectorLight const *lightsEnd   = lightsBegin + lights.size();
+
+    int lodStride = 0, lodLevel = 0;
+    QBitArray const *lodUsage = lodVertexUsage(lod, &lodStride, &lodLevel);
+
     for (dint i = 0; i < count; ++i, out++, normCoords++)
     {
-        if (activeLod && !activeLod->hasVertex(i))
+        if (lodUsage && !lodUsage->testBit(i * lodStride + lodLevel))
             continue;
 
         Vector3f const &normal = *normCoords;
 
         // Accumulate contributions from all affecting lights.
-        dint numProcessed = 0;
         Vector3f accum[2];  // Begin with total darkness [color, extra].
-        ClientApp::renderSystem().forAllVectorLights(lightListIdx, [&maxLights, &invert, &rotateYaw
-                                                      , &rotatePitch, &normal
-                                                      , &accum, &numProcessed] (VectorLightData const &vlight)
+        for (ModelVectorLight const *light = lightsBegin; light != lightsEnd; ++light)
         {
-            numProcessed += 1;
-
-            // We must transform the light vector to model space.
-            Vector3f const lightDirection
-                    = rotateLightVector(vlight, rotateYaw, rotatePitch, invert);
-
-            dfloat strength = lightDirection.dot(normal)
-                            + vlight.offset;  // Shift a bit towards the light.
+            dfloat strength = light->direction.dot(normal) + light->offset;
 
             // Ability to both light and shade.
-            if (strength > 0) strength *= vlight.lightSide;
-            else             strength *= vlight.darkSide;
-
-            accum[vlight.affectedByAmbient? 0 : 1]
-                += vlight.color * de::clamp(-1.f, strength, 1.f);
+            if (strength > 0) strength *= light->lightSide;
+            else             strength *= light->darkSide;
 
-            // Time to stop?
-            return (maxLights && duint(numProcessed) == maxLights);
-        });
+            accum[light->accumIndex] += light->color * de::clamp(-1.f, strength, 1.f);
+        }
 
         // Check for ambient and convert to ubyte.
         Vector4f color(accum[0].max(ambient) + accum[1], ambient[3]);
@@ -615,22 +689,35 @@ static void Mod_FixedVertexColors(dint count, Vector4ub *colorCoords, Vector4ub
  * Calculate cylindrically mapped, shiny texture coordinates.
  */
 static void Mod_ShinyCoords(Vector2f *out, int count, Vector3f const *normCoords,
-    float normYaw, float normPitch, float shinyAng, float shinyPnt, float reactSpeed)
+    float normYaw, float normPitch, float shinyAng, float shinyPnt, float reactSpeed,
+    FrameModelLOD const *lod)
 {
+    // Rotate the normal vectors so that they approximate the model's orientation
+    // compared to the viewer. The rotation is the same as M_RotateVector() does,
+    // but the angles are the same for all vertices.
+    float const radYaw   = (shinyPnt + normYaw) * 360 * reactSpeed / 180 * DD_PI;
+    float const radPitch = (shinyAng + normPitch - .5f) * 180 * reactSpeed / 180 * DD_PI;
+    float const cosYaw   = (radYaw   != 0? float(std::cos(radYaw))   : 1.f);
+    float const sinYaw   = (radYaw   != 0? float(std::sin(radYaw))   : 0.f);
+    float const cosPitch = (radPitch != 0? float(std::cos(radPitch)) : 1.f);
+    float const sinPitch = (radPitch != 0? float(std::sin(radPitch)) : 0.f);
+
+    int lodStride = 0, lodLevel = 0;
+    QBitArray const *lodUsage = lodVertexUsage(lod, &lodStride, &lodLevel);
+
     for (int i = 0; i < count; ++i, out++, normCoords++)
     {
-        if (activeLod && !activeLod->hasVertex(i))
+        if (lodUsage && !lodUsage->testBit(i * lodStride + lodLevel))
             continue;
 
-        float rotatedNormal[3] = { normCoords->x, normCoords->y, normCoords->z };
+        // Yaw.
+        float const x = normCoords->x * cosYaw + normCoords->y * sinYaw;
 
-        // Rotate the normal vector so that it approximates the
-        // model's orientation compared to the viewer.
-        M_RotateVector(rotatedNormal,
-                       (shinyPnt + normYaw) * 360 * reactSpeed,
-                       (shinyAng + normPitch - .5f) * 180 * reactSpeed);
+        // Pitch (only the X and Z components are needed).
+        float const rotatedX = normCoords->z * -sinPitch + x * cosPitch;
+        float const rotatedZ = normCoords->z *  cosPitch + x * sinPitch;
 
-        *out = Vector2f(rotatedNormal[0] + 1, rotatedNormal[2]);
+        *out = Vector2f(rotatedX + 1, rotatedZ);
     }
 }
 
@@ -709,10 +796,17 @@ static inline MaterialVariantSpec const &modelSkinMaterialSpec()
                                  1, -2, -1, true, true, false, false);
 }
 
-static void drawSubmodel(uint number, vissprite_t const &spr)
+/**
+ * Determines the parameters for drawing submodel @a number of @a spr, and how its
+ * vertices are to be prepared.
+ *
+ * @return  @c true= the submodel is visible and @a sub is ready to be prepared.
+ */
+static bool setupSubmodel(duint number, vissprite_t const &spr, PreparedSubmodel &sub)
 {
+    DENG_ASSERT_IN_MAIN_THREAD();
+
     drawmodelparams_t const &parm = *VS_MODEL(&spr);
-    int const zSign = (spr.pose.mirrored? -1 : 1);
     FrameModelDef *mf = parm.mf, *mfNext = parm.nextMF;
     SubmodelDef const &smf = mf->subModelDef(number);
 
@@ -720,7 +814,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
 
     // Do not bother with infinitely small models...
     if (mf->scale == Vector3f(0, 0, 0))
-        return;
+        return false;
 
     float alpha = spr.light.ambientColor[CA];
 
@@ -733,7 +827,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     }
 
     // Would this be visible?
-    if (alpha <= 0) return;
+    if (alpha <= 0) return false;
 
     blendmode_t blending = smf.blendMode;
     // Is the submodel-defined blend mode in effect?
@@ -742,8 +836,6 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
         blending = BM_ADD;
     }
 
-    int useSkin = chooseSkin(*mf, number, parm.id, parm.selector, parm.tmap);
-
     // Scale interpos. Intermark becomes zero and endmark becomes one.
     // (Full sub-interpolation!) But only do it for the standard
     // interrange. If a custom one is defined, don't touch interpos.
@@ -792,49 +884,26 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     int numVerts = mdl.vertexCount();
 
     // Ensure our vertex render buffers can accommodate this.
-    if (!resizeVertexBuffer(numVerts))
+    if (!Rend_ModelExpandVertexBuffers(numVerts))
     {
         // No can do, we aint got the power!
-        return;
-    }
-
-    // Setup transformation.
-    DGL_MatrixMode(DGL_MODELVIEW);
-    DGL_PushMatrix();
-
-    // Model space => World space
-    DGL_Translatef(spr.pose.origin[VX] + spr.pose.srvo[VX] +
-                   de::lerp(mf->offset.x, mfNext->offset.x, inter),
-                   spr.pose.origin[VZ] + spr.pose.srvo[VZ] +
-                   de::lerp(mf->offset.y, mfNext->offset.y, inter),
-                   spr.pose.origin[VY] + spr.pose.srvo[VY] + zSign *
-                   de::lerp(mf->offset.z, mfNext->offset.z, inter));
-
-    if (spr.pose.extraYawAngle || spr.pose.extraPitchAngle)
-    {
-        // Sky models have an extra rotation.
-        DGL_Scalef(1, 200 / 240.0f, 1);
-        DGL_Rotatef(spr.pose.extraYawAngle, 1, 0, 0);
-        DGL_Rotatef(spr.pose.extraPitchAngle, 0, 0, 1);
-        DGL_Scalef(1, 240 / 200.0f, 1);
+        return false;
     }
 
-    // Model rotation.
-    DGL_Rotatef(spr.pose.viewAligned? spr.pose.yawAngleOffset   : spr.pose.yaw,   0, 1, 0);
-    DGL_Rotatef(spr.pose.viewAligned? spr.pose.pitchAngleOffset : spr.pose.pitch, 0, 0, 1);
-
-    // Scaling and model space offset.
-    DGL_Scalef(de::lerp(mf->scale.x, mfNext->scale.x, inter),
-             de::lerp(mf->scale.y, mfNext->scale.y, inter),
-             de::lerp(mf->scale.z, mfNext->scale.z, inter));
-    if (spr.pose.extraScale)
-    {
-        // Particle models have an extra scale.
-        DGL_Scalef(spr.pose.extraScale, spr.pose.extraScale, spr.pose.extraScale);
-    }
-    DGL_Translatef(smf.offset.x, smf.offset.y, smf.offset.z);
+    sub.spr       = &spr;
+    sub.number    = number;
+    sub.mfNext    = mfNext;
+    sub.frame     = frame;
+    sub.nextFrame = nextFrame;
+    sub.inter     = inter;
+    sub.numVerts  = numVerts;
+    sub.mirrored  = spr.pose.mirrored;
+    sub.alpha     = alpha;
+    sub.blending  = blending;
+    sub.skin      = chooseSkin(*mf, number, parm.id, parm.selector, parm.tmap);
 
     // Determine the suitable LOD.
+    sub.lod = nullptr;
     if (mdl.lodCount() > 1 && rend_model_lod != 0)
     {
         float lodFactor = rend_model_lod * DENG_GAMEVIEW_WIDTH / 640.0f / (Rend_FieldOfView() / 90.0f);
@@ -844,125 +913,214 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
         }
 
         // Determine the LOD we will be using.
-        activeLod = &mdl.lod(de::clamp<int>(0, lodFactor * spr.pose.distance, mdl.lodCount() - 1));
-    }
-    else
-    {
-        activeLod = 0;
-    }
-
-    // Interpolate vertices and normals.
-    Mod_LerpVertices(inter, numVerts, *frame, *nextFrame,
-                     modelPosCoords, modelNormCoords);
-
-    if (zSign < 0)
-    {
-        Mod_MirrorCoords(numVerts, modelPosCoords, 2);
-        Mod_MirrorCoords(numVerts, modelNormCoords, 1);
+        sub.lod = &mdl.lod(de::clamp<int>(0, lodFactor * spr.pose.distance, mdl.lodCount() - 1));
     }
 
-    // Coordinates to the center of the model (game coords).
-    modelCenter = Vector3f(spr.pose.origin[VX], spr.pose.origin[VY], spr.pose.midZ())
-            + Vector3d(spr.pose.srvo) + Vector3f(mf->offset.x, mf->offset.z, mf->offset.y);
-
-    // Calculate lighting.
-    Vector4f ambient;
+    // Determine lighting.
     if (smf.testFlag(MFF_FULLBRIGHT) && !smf.testFlag(MFF_DIM))
     {
         // Submodel-specific lighting override.
-        ambient = Vector4f(1, 1, 1, 1);
-        Mod_FullBrightVertexColors(numVerts, modelColorCoords, alpha);
+        sub.lighting = PreparedSubmodel::FullBright;
+        sub.ambient  = Vector4f(1, 1, 1, 1);
     }
     else if (!spr.light.vLightListIdx)
     {
         // Lit uniformly.
-        ambient = Vector4f(spr.light.ambientColor, alpha);
-        Mod_FixedVertexColors(numVerts, modelColorCoords,
-                              (ambient * 255).toVector4ub());
+        sub.lighting = PreparedSubmodel::Uniform;
+        sub.ambient  = Vector4f(spr.light.ambientColor, alpha);
     }
     else
     {
         // Lit normally.
-        ambient = Vector4f(spr.light.ambientColor, alpha);
-
-        Mod_VertexColors(modelColorCoords, numVerts,
-                         modelNormCoords, spr.light.vLightListIdx, modelLight + 1,
-                         ambient, (mf->scale[VY] < 0), -spr.pose.yaw, -spr.pose.pitch);
+        sub.lighting = PreparedSubmodel::VertexLit;
+        sub.ambient  = Vector4f(spr.light.ambientColor, alpha);
+        collectModelLights(sub.lights, spr.light.vLightListIdx, modelLight + 1,
+                           (mf->scale[VY] < 0), -spr.pose.yaw, -spr.pose.pitch);
     }
 
-    TextureVariant *shinyTexture = 0;
-    float shininess = 0;
-    if (mf->def.hasSub(number))
+    sub.shininess = 0;
+    if (mf->def.hasSub(number) && mf->subModelDef(number).shinySkin)
     {
-        shininess = float(de::clamp(0.0, mf->def.sub(number).getd("shiny") * modelShinyFactor, 1.0));
-        // Ensure we've prepared the shiny skin.
-        if (shininess > 0)
-        {
-            if (ClientTexture *tex = static_cast<ClientTexture *>(mf->subModelDef(number).shinySkin))
-            {
-                shinyTexture = tex->prepareVariant(Rend_ModelShinyTextureSpec());
-            }
-            else
-            {
-                shininess = 0;
-            }
-        }
+        sub.shininess = float(de::clamp(0.0, mf->def.sub(number).getd("shiny") * modelShinyFactor, 1.0));
     }
 
-    Vector4f color;
-    if (shininess > 0)
+    if (sub.shininess > 0)
     {
-        // Calculate shiny coordinates.
-        Vector3f shinyColor = mf->def.sub(number).get("shinyColor");
+        Record const &subDef = mf->def.sub(number);
+        Vector3f shinyColor = subDef.get("shinyColor");
 
         // With psprites, add the view angle/pitch.
         float offset = parm.shineYawOffset;
 
         // Calculate normalized (0,1) model yaw and pitch.
-        float normYaw = M_CycleIntoRange(((spr.pose.viewAligned? spr.pose.yawAngleOffset
-                                                               : spr.pose.yaw) + offset) / 360, 1);
+        sub.normYaw = M_CycleIntoRange(((spr.pose.viewAligned? spr.pose.yawAngleOffset
+                                                             : spr.pose.yaw) + offset) / 360, 1);
 
         offset = parm.shinePitchOffset;
 
-        float normPitch = M_CycleIntoRange(((spr.pose.viewAligned? spr.pose.pitchAngleOffset
-                                                                 : spr.pose.pitch) + offset) / 360, 1);
+        sub.normPitch = M_CycleIntoRange(((spr.pose.viewAligned? spr.pose.pitchAngleOffset
+                                                               : spr.pose.pitch) + offset) / 360, 1);
 
-        float shinyAng = 0;
-        float shinyPnt = 0;
+        sub.shinyAng = 0;
+        sub.shinyPnt = 0;
         if (parm.shinepspriteCoordSpace)
         {
             // This is a hack to accommodate the psprite coordinate space.
-            shinyPnt = 0.5;
+            sub.shinyPnt = 0.5;
         }
         else
         {
-            Vector3f delta = modelCenter;
+            // Coordinates to the center of the model (game coords).
+            Vector3f delta = Vector3f(spr.pose.origin[VX], spr.pose.origin[VY], spr.pose.midZ())
+                    + Vector3d(spr.pose.srvo) + Vector3f(mf->offset.x, mf->offset.z, mf->offset.y);
 
             if (!parm.shineTranslateWithViewerPos)
             {
                 delta -= Rend_EyeOrigin().xzy();
             }
 
-            shinyAng = QATAN2(delta.z, M_ApproxDistancef(delta.x, delta.y)) / PI + 0.5f; // shinyAng is [0,1]
+            sub.shinyAng = QATAN2(delta.z, M_ApproxDistancef(delta.x, delta.y)) / PI + 0.5f; // shinyAng is [0,1]
 
-            shinyPnt = QATAN2(delta.y, delta.x) / (2 * PI);
+            sub.shinyPnt = QATAN2(delta.y, delta.x) / (2 * PI);
         }
 
-        Mod_ShinyCoords(modelTexCoords, numVerts,
-                        modelNormCoords, normYaw, normPitch, shinyAng, shinyPnt,
-                        mf->def.sub(number).getf("shinyReact"));
+        sub.shinyReact = subDef.getf("shinyReact");
 
         // Shiny color.
         if (smf.testFlag(MFF_SHINY_LIT))
         {
-            color = Vector4f(ambient * shinyColor, shininess);
+            sub.shinyColor = Vector4f(sub.ambient * shinyColor, sub.shininess);
         }
         else
         {
-            color = Vector4f(shinyColor, shininess);
+            sub.shinyColor = Vector4f(shinyColor, sub.shininess);
         }
     }
 
+    // Vertex buffers are reused, so they only grow to the largest model.
+    sub.posCoords  .reserve(vertexBufferMax);
+    sub.normCoords .reserve(vertexBufferMax);
+    sub.colorCoords.reserve(vertexBufferMax);
+    sub.texCoords  .reserve(vertexBufferMax);
+    sub.posCoords  .resize(numVerts);
+    sub.normCoords .resize(numVerts);
+    sub.colorCoords.resize(numVerts);
+    sub.texCoords  .resize(numVerts);
+
+    return true;
+}
+
+/**
+ * Interpolate, light and map the vertices of a submodel. This can be called on any
+ * thread.
+ */
+static void prepareVertices(PreparedSubmodel &sub)
+{
+    dint const numVerts = sub.numVerts;
+    Vector3f *posCoords = sub.posCoords.data();
+    Vector3f *normCoords = sub.normCoords.data();
+
+    // Interpolate vertices and normals.
+    Mod_LerpVertices(sub.inter, numVerts, *sub.frame, *sub.nextFrame, posCoords, normCoords);
+
+    if (sub.mirrored)
+    {
+        Mod_MirrorCoords(numVerts, posCoords, 2);
+        Mod_MirrorCoords(numVerts, normCoords, 1);
+    }
+
+    // Calculate lighting.
+    switch (sub.lighting)
+    {
+    case PreparedSubmodel::FullBright:
+        Mod_FullBrightVertexColors(numVerts, sub.colorCoords.data(), sub.alpha);
+        break;
+
+    case PreparedSubmodel::Uniform:
+        Mod_FixedVertexColors(numVerts, sub.colorCoords.data(), (sub.ambient * 255).toVector4ub());
+        break;
+
+    case PreparedSubmodel::VertexLit:
+        Mod_VertexColors(sub.colorCoords.data(), numVerts, normCoords, sub.lights, sub.ambient,
+                         sub.lod);
+        break;
+    }
+
+    if (sub.shininess > 0)
+    {
+        // Calculate shiny coordinates.
+        Mod_ShinyCoords(sub.texCoords.data(), numVerts, normCoords, sub.normYaw, sub.normPitch,
+                        sub.shinyAng, sub.shinyPnt, sub.shinyReact, sub.lod);
+    }
+}
+
+static void drawSubmodel(PreparedSubmodel &sub)
+{
+    DENG_ASSERT_IN_MAIN_THREAD();
+    DENG_ASSERT_GL_CONTEXT_ACTIVE();
+
+    vissprite_t const &spr = *sub.spr;
+    drawmodelparams_t const &parm = *VS_MODEL(&spr);
+    FrameModelDef const *mf = parm.mf, *mfNext = sub.mfNext;
+    SubmodelDef const &smf = mf->subModelDef(sub.number);
+    FrameModel &mdl = App_Resources().model(smf.modelId);
+    int const zSign = (sub.mirrored? -1 : 1);
+    float const inter = sub.inter;
+
+    bool const disableZ = (mf->flags & MFF_DISABLE_Z_WRITE ||
+                           mf->testSubFlag(sub.number, MFF_DISABLE_Z_WRITE));
+    if (disableZ)
+    {
+        DGL_Disable(DGL_DEPTH_WRITE);
+    }
+
+    // Setup transformation.
+    DGL_MatrixMode(DGL_MODELVIEW);
+    DGL_PushMatrix();
+
+    // Model space => World space
+    DGL_Translatef(spr.pose.origin[VX] + spr.pose.srvo[VX] +
+                   de::lerp(mf->offset.x, mfNext->offset.x, inter),
+                   spr.pose.origin[VZ] + spr.pose.srvo[VZ] +
+                   de::lerp(mf->offset.y, mfNext->offset.y, inter),
+                   spr.pose.origin[VY] + spr.pose.srvo[VY] + zSign *
+                   de::lerp(mf->offset.z, mfNext->offset.z, inter));
+
+    if (spr.pose.extraYawAngle || spr.pose.extraPitchAngle)
+    {
+        // Sky models have an extra rotation.
+        DGL_Scalef(1, 200 / 240.0f, 1);
+        DGL_Rotatef(spr.pose.extraYawAngle, 1, 0, 0);
+        DGL_Rotatef(spr.pose.extraPitchAngle, 0, 0, 1);
+        DGL_Scalef(1, 240 / 200.0f, 1);
+    }
+
+    // Model rotation.
+    DGL_Rotatef(spr.pose.viewAligned? spr.pose.yawAngleOffset   : spr.pose.yaw,   0, 1, 0);
+    DGL_Rotatef(spr.pose.viewAligned? spr.pose.pitchAngleOffset : spr.pose.pitch, 0, 0, 1);
+
+    // Scaling and model space offset.
+    DGL_Scalef(de::lerp(mf->scale.x, mfNext->scale.x, inter),
+             de::lerp(mf->scale.y, mfNext->scale.y, inter),
+             de::lerp(mf->scale.z, mfNext->scale.z, inter));
+    if (spr.pose.extraScale)
+    {
+        // Particle models have an extra scale.
+        DGL_Scalef(spr.pose.extraScale, spr.pose.extraScale, spr.pose.extraScale);
+    }
+    DGL_Translatef(smf.offset.x, smf.offset.y, smf.offset.z);
+
+    float const shininess = sub.shininess;
+    float const alpha     = sub.alpha;
+    Vector4f const &color = sub.shinyColor;
+
+    TextureVariant *shinyTexture = 0;
+    if (shininess > 0)
+    {
+        // Ensure we've prepared the shiny skin.
+        shinyTexture = static_cast<ClientTexture *>(smf.shinySkin)->prepareVariant(Rend_ModelShinyTextureSpec());
+    }
+
     TextureVariant *skinTexture = 0;
     if (renderTextures == 2)
     {
@@ -978,7 +1136,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     else
     {
         skinTexture = 0;
-        if (ClientTexture *tex = static_cast<ClientTexture *>(mdl.skin(useSkin).texture))
+        if (ClientTexture *tex = static_cast<ClientTexture *>(mdl.skin(sub.skin).texture))
         {
             skinTexture = tex->prepareVariant(Rend_ModelDiffuseTextureSpec(mdl.flags().testFlag(FrameModel::NoTextureCompression)));
         }
@@ -999,21 +1157,25 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     DGL_Enable(DGL_TEXTURE_2D);
 
     FrameModel::Primitives const &primitives =
-        activeLod? activeLod->primitives : mdl.primitives();
+        sub.lod? sub.lod->primitives : mdl.primitives();
+
+    Vector3f *posCoords = sub.posCoords.data();
+    Vector4ub *colorCoords = sub.colorCoords.data();
+    Vector2f *texCoords = sub.texCoords.data();
 
     // Render using multiple passes?
     if (shininess <= 0 || alpha < 1 ||
-        blending != BM_NORMAL || !smf.testFlag(MFF_SHINY_SPECULAR))
+        sub.blending != BM_NORMAL || !smf.testFlag(MFF_SHINY_SPECULAR))
     {
         // The first pass can be skipped if it won't be visible.
         if (shininess < 1 || smf.testFlag(MFF_SHINY_SPECULAR))
         {
             selectTexUnits(1);
-            GL_BlendMode(blending);
+            GL_BlendMode(sub.blending);
             GL_BindTexture(renderTextures? skinTexture : 0);
 
             drawPrimitives(RC_COMMAND_COORDS, primitives,
-                           modelPosCoords, modelColorCoords);
+                           posCoords, colorCoords);
         }
 
         if (shininess > 0)
@@ -1027,7 +1189,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
                 GL_BlendMode(BM_NORMAL);
 
             // Shiny color.
-            Mod_FixedVertexColors(numVerts, modelColorCoords,
+            Mod_FixedVertexColors(sub.numVerts, colorCoords,
                                   (color * 255).toVector4ub());
 
             // We'll use multitexturing to clear out empty spots in
@@ -1042,7 +1204,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
             GL_BindTexture(renderTextures? skinTexture : 0);
 
             drawPrimitives(RC_BOTH_COORDS, primitives,
-                           modelPosCoords, modelColorCoords, modelTexCoords);
+                           posCoords, colorCoords, texCoords);
 
             selectTexUnits(1);
             DGL_ModulateTexture(1);
@@ -1052,7 +1214,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     {
         // A special case: specular shininess on an opaque object.
         // Multitextured shininess with the normal blending.
-        GL_BlendMode(blending);
+        GL_BlendMode(sub.blending);
         selectTexUnits(2);
 
         // Tex1*Color + Tex2RGB*ConstRGB
@@ -1069,7 +1231,7 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
         GL_BindTexture(renderTextures? skinTexture : 0);
 
         drawPrimitives(RC_BOTH_COORDS, primitives,
-                       modelPosCoords, modelColorCoords, modelTexCoords);
+                       posCoords, colorCoords, texCoords);
 
         selectTexUnits(1);
         DGL_ModulateTexture(1);
@@ -1095,6 +1257,59 @@ static void drawSubmodel(uint number, vissprite_t const &spr)
     DGL_DepthFunc(DGL_LESS);
 
     GL_BlendMode(BM_NORMAL);
+
+    if (disableZ)
+    {
+        DGL_Enable(DGL_DEPTH_WRITE);
+    }
+}
+
+/**
+ * Prepares the vertices of @a count submodels concurrently.
+ */
+static void prepareAllVertices(PreparedSubmodel *subs, dint count)
+{
+    TaskPool::parallelFor(count, [subs] (dint begin, dint end)
+    {
+        for (dint i = begin; i < end; ++i)
+        {
+            prepareVertices(subs[i]);
+        }
+    });
+}
+
+void Rend_PrepareModels(QVector<vissprite_t const *> const &sprites)
+{
+    DENG2_ASSERT(inited);
+    DENG_ASSERT_IN_MAIN_THREAD();
+
+    preparedModels.clear();
+    preparedCount = 0;
+
+    for (vissprite_t const *spr : sprites)
+    {
+        drawmodelparams_t const &parm = *VS_MODEL(spr);
+        if (!parm.mf) continue;
+
+        DENG2_ASSERT(parm.mf->select == (parm.selector & DDMOBJ_SELECTOR_MASK))
+
+        preparedModels.insert(spr, preparedCount);
+        for (uint i = 0; i < parm.mf->subCount(); ++i)
+        {
+            if (!parm.mf->subModelId(i)) continue;
+
+            if (preparedCount == preparedSubmodels.size())
+            {
+                preparedSubmodels.append(PreparedSubmodel());
+            }
+            if (setupSubmodel(i, *spr, preparedSubmodels[preparedCount]))
+            {
+                preparedCount += 1;
+            }
+        }
+    }
+
+    prepareAllVertices(preparedSubmodels.data(), preparedCount);
 }
 
 void Rend_DrawModel(vissprite_t const &spr)
@@ -1110,23 +1325,26 @@ void Rend_DrawModel(vissprite_t const &spr)
     DENG2_ASSERT(parm.mf->select == (parm.selector & DDMOBJ_SELECTOR_MASK))
 
     // Render all the submodels of this model.
-    for (uint i = 0; i < parm.mf->subCount(); ++i)
+    auto found = preparedModels.find(&spr);
+    if (found != preparedModels.end())
     {
-        if (parm.mf->subModelId(i))
+        // Prepared ahead of time (see Rend_PrepareModels).
+        for (dint i = found.value(); i < preparedCount && preparedSubmodels[i].spr == &spr; ++i)
         {
-            bool disableZ = (parm.mf->flags & MFF_DISABLE_Z_WRITE ||
-                             parm.mf->testSubFlag(i, MFF_DISABLE_Z_WRITE));
-
-            if (disableZ)
-            {
-                DGL_Disable(DGL_DEPTH_WRITE);
-            }
-
-            drawSubmodel(i, spr);
+            drawSubmodel(preparedSubmodels[i]);
+        }
+        preparedModels.erase(found);
+    }
+    else
+    {
+        static PreparedSubmodel sub; // Reused between calls.
 
-            if (disableZ)
+        for (uint i = 0; i < parm.mf->subCount(); ++i)
+        {
+            if (parm.mf->subModelId(i) && setupSubmodel(i, spr, sub))
             {
-                DGL_Enable(DGL_DEPTH_WRITE);
+                prepareVertices(sub);
+                drawSubmodel(sub);
             }
         }
     }
@@ -1175,3 +1393,109 @@ TextureVariantSpec const &Rend_ModelShinyTextureSpec()
         TSF_NO_COMPRESSION, 0, 0, 0, GL_REPEAT, GL_REPEAT, 1, -2, -1, false,
         false, false, false);
 }
+
+/**
+ * Benchmarks the preparation of frame model vertices. One submodel is prepared for
+ * each loaded frame model: interpolated halfway between its first two frames, lit
+ * by several vector lights, and with shiny texture coordinates. Nothing is drawn,
+ * so only the vertex preparation is measured.
+ */
+D_CMD(ProfileModels)
+{
+    DENG2_UNUSED(src);
+
+    dint const iterations = (argc > 1? String(argv[1]).toInt() : 100);
+    if (iterations < 1)
+    {
+        LOG_SCR_ERROR("Invalid number of iterations %i") << iterations;
+        return false;
+    }
+
+    // Lights around the model, as many as are used when drawing.
+    QVector<ModelVectorLight> lights;
+    for (dint i = 0; i < modelLight + 1; ++i)
+    {
+        dfloat const angle = i * 2 * float(PI) / (modelLight + 1);
+
+        ModelVectorLight ml;
+        ml.direction  = Vector3f(std::cos(angle), std::sin(angle), .5f).normalize();
+        ml.color      = Vector3f(1, .8f, .6f);
+        ml.offset     = .3f;
+        ml.lightSide  = 1;
+        ml.darkSide   = 0;
+        ml.accumIndex = (i == 0? 0 : 1);
+        lights << ml;
+    }
+
+    QVector<PreparedSubmodel> subs;
+    QSet<FrameModel const *> models;
+    dint vertexCount = 0;
+    for (dint i = 0; i < App_Resources().modelDefCount(); ++i)
+    {
+        FrameModelDef &modef = App_Resources().modelDef(i);
+        for (uint k = 0; k < modef.subCount(); ++k)
+        {
+            if (!modef.subModelId(k)) continue;
+
+            FrameModel &mdl = App_Resources().model(modef.subModelId(k));
+            if (models.contains(&mdl) || !mdl.frameCount() ||
+                !Rend_ModelExpandVertexBuffers(mdl.vertexCount()))
+            {
+                continue;
+            }
+            models.insert(&mdl);
+
+            PreparedSubmodel sub;
+            sub.frame      = &mdl.frame(0);
+            sub.nextFrame  = &mdl.frame(mdl.frameCount() > 1? 1 : 0);
+            sub.inter      = .5f;
+            sub.numVerts   = mdl.vertexCount();
+            sub.alpha      = 1;
+            sub.lighting   = PreparedSubmodel::VertexLit;
+            sub.ambient    = Vector4f(.2f, .2f, .2f, 1);
+            sub.lights     = lights;
+            sub.shininess  = 1;
+            sub.shinyReact = 1;
+            sub.posCoords  .resize(sub.numVerts);
+            sub.normCoords .resize(sub.numVerts);
+            sub.colorCoords.resize(sub.numVerts);
+            sub.texCoords  .resize(sub.numVerts);
+            subs << sub;
+
+            vertexCount += sub.numVerts;
+        }
+    }
+
+    if (subs.isEmpty())
+    {
+        LOG_SCR_ERROR("No frame models are loaded");
+        return false;
+    }
+
+    Time startedAt;
+    for (dint i = 0; i < iterations; ++i)
+    {
+        for (PreparedSubmodel &sub : subs)
+        {
+            prepareVertices(sub);
+        }
+    }
+    TimeSpan const serialTime = startedAt.since();
+
+    startedAt = Time();
+    for (dint i = 0; i < iterations; ++i)
+    {
+        prepareAllVertices(subs.data(), subs.size());
+    }
+    TimeSpan const parallelTime = startedAt.since();
+
+    auto const perIteration = [&iterations] (ddouble seconds) { return seconds * 1000 / iterations; };
+
+    LOG_SCR_MSG(_E(b) "Model vertex preparation: %i submodels, %i vertices, %i iterations")
+            << subs.size() << vertexCount << iterations;
+    LOG_SCR_MSG("  Serial: %.3f ms per iteration") << perIteration(serialTime);
+    LOG_SCR_MSG("  Parallel: %.3f ms per iteration (%.1fx)")
+            << perIteration(parallelTime)
+            << (ddouble(parallelTime) > 0? ddouble(serialTime) / ddouble(parallelTime) : 0.0);
+    return true;
+}
@@ -42,9 +42,11 @@
 #include "render/vissprite.h"
 
 #include "clientapp.h"
+#include "dd_main.h"  // App_World()
 #include "misc/r_util.h"
 #include "sys_system.h"  // novideo
 
+#include <doomsday/console/cmd.h>
 #include <doomsday/console/var.h>
 #include <doomsday/filesys/fs_main.h>
 #include <de/concurrency.h>
@@ -52,7 +54,11 @@
 #include <de/Folder>
 #include <de/GLInfo>
 #include <de/ImageFile>
+#include <de/Time>
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <utility>
 
 using namespace de;
 using namespace world;
@@ -72,6 +78,7 @@ struct OrderedParticle
     dfloat distance;
 };
 static OrderedParticle *order;
+static OrderedParticle *sortBuffer;  ///< Scratch space for sorting the order buffer.
 static size_t orderSize;
 
 static size_t numParts;
@@ -84,11 +91,12 @@ static dint maxParticles;           ///< @c 0= Unlimited.
 static dint particleNearLimit;
 static dfloat particleDiffuse = 4;
 
-static dfloat pointDist(fixed_t const c[3])
+D_CMD(ProfileParticles);
+
+static dfloat pointDist(viewdata_t const &viewData, fixed_t const c[3])
 {
-    viewdata_t const *viewData = &viewPlayer->viewport();
-    dfloat dist = ((viewData->current.origin.y - FIX2FLT(c[1])) * -viewData->viewSin)
-                - ((viewData->current.origin.x - FIX2FLT(c[0])) * viewData->viewCos);
+    dfloat dist = ((viewData.current.origin.y - FIX2FLT(c[1])) * -viewData.viewSin)
+                - ((viewData.current.origin.x - FIX2FLT(c[0])) * viewData.viewCos);
 
     return de::abs(dist);  // Always return positive.
 }
@@ -248,16 +256,69 @@ void Rend_ParticleReleaseExtraTextures()
 }
 
 /**
- * Sorts in descending order.
+ * Returns the radix sort key of a particle. Distances are always positive, so the
+ * bits of the float compare in the same order as the values; inverting them gives
+ * a key that sorts in descending order.
  */
-static dint comparePOrder(void const *a, void const *b)
+static inline duint32 particleSortKey(OrderedParticle const &pt)
 {
-    auto const &ptA = *(OrderedParticle const *) a;
-    auto const &ptB = *(OrderedParticle const *) b;
+    duint32 bits;
+    std::memcpy(&bits, &pt.distance, sizeof(bits));
+    return ~bits;
+}
+
+/**
+ * Sorts particles back->front (in descending order of distance) using a least
+ * significant digit radix sort, one byte of the key per pass. The passes alternate
+ * between @a items and @a scratch, so the pointers may be swapped on return.
+ */
+static void radixSortParticles(OrderedParticle *&items, OrderedParticle *&scratch, size_t count)
+{
+    if(!count) return;
+
+    size_t histogram[4][256];
+    de::zap(histogram);
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        duint32 const key = particleSortKey(items[i]);
+        for(dint pass = 0; pass < 4; ++pass)
+        {
+            histogram[pass][(key >> (pass * 8)) & 0xff]++;
+        }
+    }
+
+    for(dint pass = 0; pass < 4; ++pass)
+    {
+        dint const shift = pass * 8;
+        size_t *offsets  = histogram[pass];
+
+        // Nothing to do if all keys have the same digit in this position.
+        if(offsets[(particleSortKey(items[0]) >> shift) & 0xff] == count)
+            continue;
 
-    if(ptA.distance > ptB.distance) return -1;
-    if(ptA.distance < ptB.distance) return 1;
-    return 0;  // Highly unlikely (but possible).
+        size_t total = 0;
+        for(dint digit = 0; digit < 256; ++digit)
+        {
+            size_t const digitCount = offsets[digit];
+            offsets[digit] = total;
+            total += digitCount;
+        }
+
+        for(size_t i = 0; i < count; ++i)
+        {
+            scratch[offsets[(particleSortKey(items[i]) >> shift) & 0xff]++] = items[i];
+        }
+        std::swap(items, scratch);
+    }
+}
+
+/**
+ * Sorts the order buffer back->front.
+ */
+static void sortOrderBuffer()
+{
+    radixSortParticles(order, sortBuffer, numParts);
 }
 
 /**
@@ -281,7 +342,8 @@ static void expandOrderBuffer(size_t max)
 
     if(orderSize > currentSize)
     {
-        order = (OrderedParticle *) Z_Realloc(order, sizeof(OrderedParticle) * orderSize, PU_APPSTATIC);
+        order      = (OrderedParticle *) Z_Realloc(order, sizeof(OrderedParticle) * orderSize, PU_APPSTATIC);
+        sortBuffer = (OrderedParticle *) Z_Realloc(sortBuffer, sizeof(OrderedParticle) * orderSize, PU_APPSTATIC);
     }
 }
 
@@ -327,8 +389,9 @@ static dint listVisibleParticles(world::Map &map)
 
     // Populate the particle sort buffer and determine what type(s) of
     // particle (model/point/line/etc...) we'll need to draw.
+    viewdata_t const &viewData = viewPlayer->viewport();
     size_t numVisibleParts = 0;
-    map.forAllGenerators([&numVisibleParts] (Generator &gen)
+    map.forAllGenerators([&viewData, &numVisibleParts] (Generator &gen)
     {
         if(!R_ViewerGeneratorIsVisible(gen)) return LoopContinue;  // Skip.
 
@@ -339,7 +402,7 @@ static dint listVisibleParticles(world::Map &map)
             if(!particlePVisible(pinfo)) continue;  // Skip.
 
             // Skip particles too far from, or near to, the viewer.
-            dfloat const dist = de::max(pointDist(pinfo.origin), 1.f);
+            dfloat const dist = de::max(pointDist(viewData, pinfo.origin), 1.f);
             if(gen.def->maxDist != 0 && dist > gen.def->maxDist) continue;
             if(dist < dfloat( ::particleNearLimit )) continue;
 
@@ -394,8 +457,8 @@ static dint listVisibleParticles(world::Map &map)
     // This is the real number of possibly visible particles.
     ::numParts = numVisibleParts;
 
-    // Sort the order list back->front. A quicksort is fast enough.
-    qsort(::order, ::numParts, sizeof(OrderedParticle), comparePOrder);
+    // Sort the order list back->front.
+    sortOrderBuffer();
 
     return true;
 }
@@ -904,4 +967,95 @@ void Rend_ParticleRegister()
     C_VAR_INT  ("rend-particle-max",               &maxParticles,      CVF_NO_MAX,     0, 0);
     C_VAR_FLOAT("rend-particle-diffuse",           &particleDiffuse,   CVF_NO_MAX,     0, 0);
     C_VAR_INT  ("rend-particle-visible-near",      &particleNearLimit, CVF_NO_MAX,     0, 0);
+
+    C_CMD("particleprofile", "",  ProfileParticles);
+    C_CMD("particleprofile", "i", ProfileParticles);
+}
+
+/**
+ * Benchmarks the ordering of particles. A snapshot of the distances of all the
+ * active particles in the current map, as seen by the console player, is sorted
+ * repeatedly with the radix sort used when rendering and, for comparison, with a
+ * comparison sort. Nothing is drawn.
+ */
+D_CMD(ProfileParticles)
+{
+    DENG2_UNUSED(src);
+
+    if(!App_World().hasMap())
+    {
+        LOG_SCR_ERROR("No map is currently loaded");
+        return false;
+    }
+
+    dint const iterations = (argc > 1? String(argv[1]).toInt() : 100);
+    if(iterations < 1)
+    {
+        LOG_SCR_ERROR("Invalid number of iterations %i") << iterations;
+        return false;
+    }
+
+    // Take a snapshot of the particles.
+    viewdata_t const &viewData = DD_Player(consolePlayer)->viewport();
+    QVector<OrderedParticle> snapshot;
+    App_World().map().forAllGenerators([&viewData, &snapshot] (Generator &gen)
+    {
+        for(dint i = 0; i < gen.count; ++i)
+        {
+            ParticleInfo const &pinfo = gen.particleInfo()[i];
+            if(pinfo.stage < 0) continue;
+
+            OrderedParticle pt;
+            pt.generator  = &gen;
+            pt.particleId = i;
+            pt.distance   = de::max(pointDist(viewData, pinfo.origin), 1.f);
+            snapshot << pt;
+        }
+        return LoopContinue;
+    });
+
+    if(snapshot.isEmpty())
+    {
+        LOG_SCR_ERROR("There are no active particles in the map");
+        return false;
+    }
+
+    size_t const count = size_t(snapshot.size());
+    QVector<OrderedParticle> buffer(snapshot.size()), scratch(snapshot.size());
+    OrderedParticle *sorted = nullptr;
+
+    Time startedAt;
+    for(dint i = 0; i < iterations; ++i)
+    {
+        std::memcpy(buffer.data(), snapshot.constData(), sizeof(OrderedParticle) * count);
+        OrderedParticle *items = buffer.data(), *temp = scratch.data();
+        radixSortParticles(items, temp, count);
+        sorted = items;
+    }
+    TimeSpan const radixTime = startedAt.since();
+
+    // Check the order.
+    bool inOrder = true;
+    for(size_t i = 1; i < count && inOrder; ++i)
+    {
+        inOrder = (sorted[i - 1].distance >= sorted[i].distance);
+    }
+
+    startedAt = Time();
+    for(dint i = 0; i < iterations; ++i)
+    {
+        std::memcpy(buffer.data(), snapshot.constData(), sizeof(OrderedParticle) * count);
+        std::sort(buffer.begin(), buffer.end(), [] (OrderedParticle const &a, OrderedParticle const &b) {
+            return a.distance > b.distance;
+        });
+    }
+    TimeSpan const comparisonTime = startedAt.since();
+
+    auto const perIteration = [&iterations] (ddouble seconds) { return seconds * 1000 / iterations; };
+
+    LOG_SCR_MSG(_E(b) "Particle ordering: %i particles, %i iterations") << dint(count) << iterations;
+    LOG_SCR_MSG("  Radix sort: %.3f ms per iteration%s")
+            << perIteration(radixTime) << (inOrder? "" : " " _E(1) "(INCORRECT ORDER)");
+    LOG_SCR_MSG("  Comparison sort: %.3f ms per iteration") << perIteration(comparisonTime);
+    return inOrder;
 }
@@ -34,10 +34,49 @@
 #include "MaterialAnimator"
 #include "WallEdge"
 
+#include <QHash>
+
 using namespace world;
 
 namespace de {
 
+namespace {
+
+/**
+ * Previously prepared state of a shadow edge. Valid until the geometry around the
+ * edge's vertex changes.
+ */
+struct CachedShadowEdge
+{
+    duint stamp = 0;
+    coord_t planeHeight = 0;  ///< The visual plane may belong to another sector.
+    Vector3d inner;
+    Vector3d outer;
+    dfloat sectorOpenness = 0;
+    dfloat openness = 0;
+};
+
+struct CachedShadowEdgeKey
+{
+    HEdge const *hedge;
+    dint edge;
+    dint planeIndex;
+
+    bool operator == (CachedShadowEdgeKey const &other) const
+    {
+        return hedge == other.hedge && edge == other.edge && planeIndex == other.planeIndex;
+    }
+};
+
+inline uint qHash(CachedShadowEdgeKey const &key)
+{
+    return ::qHash(key.hedge) ^ uint((key.planeIndex << 1) | key.edge);
+}
+
+} // namespace
+
+static QHash<CachedShadowEdgeKey, CachedShadowEdge> shadowEdgeCache;
+
 DENG2_PIMPL_NOREF(ShadowEdge)
 {
     HEdge const *leftMostHEdge = nullptr;
@@ -47,6 +86,8 @@ DENG2_PIMPL_NOREF(ShadowEdge)
     Vector3d outer;
     dfloat sectorOpenness = 0;
     dfloat openness = 0;
+
+    void evaluate(dint planeIndex);
 };
 
 ShadowEdge::ShadowEdge() : d(new Impl)
@@ -151,17 +192,17 @@ static bool middleMaterialCoversOpening(LineSide const &side)
     return false;
 }
 
-void ShadowEdge::prepare(dint planeIndex)
+void ShadowEdge::Impl::evaluate(dint planeIndex)
 {
     dint const otherPlaneIndex = planeIndex == Sector::Floor? Sector::Ceiling : Sector::Floor;
-    HEdge const &hedge = *d->leftMostHEdge;
+    HEdge const &hedge = *leftMostHEdge;
     auto const &subsec = hedge.face().mapElementAs<ConvexSubspace>()
                             .subsector().as<world::ClientSubsector>();
     Plane const &plane = subsec.visPlane(planeIndex);
 
     LineSide const &lineSide = hedge.mapElementAs<LineSideSegment>().lineSide();
 
-    d->sectorOpenness = d->openness = 0; // Default is fully closed.
+    sectorOpenness = openness = 0; // Default is fully closed.
 
     // Determine the 'openness' of the wall edge sector. If the sector is open,
     // there won't be a shadow at all. Open neighbor sectors cause some changes
@@ -194,14 +235,14 @@ void ShadowEdge::prepare(dint planeIndex)
         // Determine openness.
         if (fz < bz && !wallEdgeSurface.hasMaterial())
         {
-            d->sectorOpenness = 2; // Consider it fully open.
+            sectorOpenness = 2; // Consider it fully open.
         }
         // Is the back sector a closed yet sky-masked surface?
         else if (subsec.visFloor().heightSmoothed() >= backSubsec.visCeiling().heightSmoothed() &&
                  subsec    .visPlane(otherPlaneIndex).surface().hasSkyMaskedMaterial() &&
                  backSubsec.visPlane(otherPlaneIndex).surface().hasSkyMaskedMaterial())
         {
-            d->sectorOpenness = 2; // Consider it fully open.
+            sectorOpenness = 2; // Consider it fully open.
         }
         else
         {
@@ -209,45 +250,45 @@ void ShadowEdge::prepare(dint planeIndex)
             // not want to give away the location of any secret areas)?
             if (!middleMaterialCoversOpening(lineSide))
             {
-                d->sectorOpenness = opennessFactor(fz, bz, bhz);
+                sectorOpenness = opennessFactor(fz, bz, bhz);
             }
         }
     }
 
     // Only calculate the remaining values when the edge is at least partially open.
-    if (d->sectorOpenness >= 1)
+    if (sectorOpenness >= 1)
         return;
 
     // Find the neighbor of this wall section and determine the relative
     // 'openness' of it's plane heights vs those of "this" wall section.
     /// @todo fixme: Should use the visual plane heights of subsectors.
 
-    dint const edge = lineSide.sideId() ^ d->edge;
-    LineOwner const *vo = lineSide.line().vertexOwner(edge)->navigate(ClockDirection(d->edge ^ 1));
+    dint const vertexIndex = lineSide.sideId() ^ edge;
+    LineOwner const *vo = lineSide.line().vertexOwner(vertexIndex)->navigate(ClockDirection(edge ^ 1));
     Line const &neighborLine = vo->line();
 
     if (&neighborLine == &lineSide.line())
     {
-        d->openness = 1; // Fully open.
+        openness = 1; // Fully open.
     }
     else if (neighborLine.isSelfReferencing()) /// @todo Skip over these? -ds
     {
-        d->openness = 1;
+        openness = 1;
     }
     else
     {
         // Choose the correct side of the neighbor (determined by which vertex is shared).
-        LineSide const &neighborLineSide = neighborLine.side(&lineSide.line().vertex(edge) == &neighborLine.from()? d->edge ^ 1 : d->edge);
+        LineSide const &neighborLineSide = neighborLine.side(&lineSide.line().vertex(vertexIndex) == &neighborLine.from()? edge ^ 1 : edge);
 
         if (!neighborLineSide.hasSections() && neighborLineSide.back().hasSector())
         {
             // A one-way window, open side.
-            d->openness = 1;
+            openness = 1;
         }
         else if (!neighborLineSide.hasSector() ||
                  (neighborLineSide.back().hasSector() && middleMaterialCoversOpening(neighborLineSide)))
         {
-            d->openness = 0;
+            openness = 0;
         }
         else if (neighborLineSide.back().hasSector())
         {
@@ -270,26 +311,58 @@ void ShadowEdge::prepare(dint planeIndex)
                 if (planeIndex == Sector::Ceiling)
                     bhz = -bhz;
 
-                d->openness = opennessFactor(fz, bz, bhz);
+                openness = opennessFactor(fz, bz, bhz);
             }
         }
     }
 
-    if (d->openness < 1)
+    if (openness < 1)
     {
-        LineOwner *vo = lineSide.line().vertexOwner(lineSide.sideId() ^ d->edge);
-        if (d->edge) vo = vo->prev();
+        LineOwner *vo = lineSide.line().vertexOwner(lineSide.sideId() ^ edge);
+        if (edge) vo = vo->prev();
 
-        d->inner = Vector3d(lineSide.vertex(d->edge).origin() + vo->innerShadowOffset(),
-                            plane.heightSmoothed());
+        inner = Vector3d(lineSide.vertex(edge).origin() + vo->innerShadowOffset(),
+                         plane.heightSmoothed());
     }
     else
     {
-        d->inner = Vector3d(lineSide.vertex(d->edge).origin() + vo->extendedShadowOffset(),
-                            plane.heightSmoothed());
+        inner = Vector3d(lineSide.vertex(edge).origin() + vo->extendedShadowOffset(),
+                         plane.heightSmoothed());
     }
 
-    d->outer = Vector3d(lineSide.vertex(d->edge).origin(), plane.heightSmoothed());
+    outer = Vector3d(lineSide.vertex(edge).origin(), plane.heightSmoothed());
+}
+
+void ShadowEdge::prepare(dint planeIndex)
+{
+    HEdge const &hedge = *d->leftMostHEdge;
+    LineSide const &lineSide = hedge.mapElementAs<LineSideSegment>().lineSide();
+    LineOwner const *base = lineSide.line().vertexOwner(lineSide.sideId() ^ d->edge);
+    duint const stamp = ClientSubsector::vertexGeometryVersion(*base);
+    coord_t const planeHeight = hedge.face().mapElementAs<ConvexSubspace>().subsector()
+                                    .as<ClientSubsector>().visPlane(planeIndex).heightSmoothed();
+
+    // The result only depends on the planes and surfaces around the vertex.
+    auto found = shadowEdgeCache.constFind(CachedShadowEdgeKey{ d->leftMostHEdge, d->edge, planeIndex });
+    if (found != shadowEdgeCache.constEnd() && found->stamp == stamp
+        && found->planeHeight == planeHeight)
+    {
+        d->inner          = found->inner;
+        d->outer          = found->outer;
+        d->sectorOpenness = found->sectorOpenness;
+        d->openness       = found->openness;
+        return;
+    }
+
+    d->evaluate(planeIndex);
+
+    CachedShadowEdge &cached = shadowEdgeCache[CachedShadowEdgeKey{ d->leftMostHEdge, d->edge, planeIndex }];
+    cached.stamp          = stamp;
+    cached.planeHeight    = planeHeight;
+    cached.inner          = d->inner;
+    cached.outer          = d->outer;
+    cached.sectorOpenness = d->sectorOpenness;
+    cached.openness       = d->openness;
 }
 
 Vector3d const &ShadowEdge::inner() const
@@ -324,4 +397,9 @@ dfloat ShadowEdge::shadowStrength(dfloat darkness) const
     return 0;
 }
 
+void ShadowEdge::clearCache() // static
+{
+    shadowEdgeCache.clear();
+}
+
 }  // namespace de
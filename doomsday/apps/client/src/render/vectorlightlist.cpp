@@ -21,14 +21,18 @@
 #include <de/memoryzone.h>
 
 VectorLightList::Node *VectorLightList::firstNode  = nullptr;
+VectorLightList::Node *VectorLightList::lastNode   = nullptr;
 VectorLightList::Node *VectorLightList::cursorNode = nullptr;
 
+static de::dint const NODE_BLOCK_SIZE = 256;  ///< Nodes allocated at once.
+
 void VectorLightList::init()  // static
 {
     static bool firstTime = true;
     if(firstTime)
     {
         firstNode  = 0;
+        lastNode   = 0;
         cursorNode = 0;
         firstTime  = false;
     }
@@ -77,23 +81,27 @@ VectorLightList &VectorLightList::add(VectorLightData &vlight)
 
 VectorLightList::Node *VectorLightList::newNode()  // static
 {
-    Node *node;
-
     // Do we need to allocate more nodes?
     if(!cursorNode)
     {
-        node = (Node *) Z_Malloc(sizeof(*node), PU_APPSTATIC, nullptr);
+        // Allocate a block of nodes at once and link them to the end of the list, so
+        // that they are reused in order after the next rewind.
+        auto *block = (Node *) Z_Malloc(sizeof(Node) * NODE_BLOCK_SIZE, PU_APPSTATIC, nullptr);
+        for(de::dint i = 0; i < NODE_BLOCK_SIZE - 1; ++i)
+        {
+            block[i].nextUsed = &block[i + 1];
+        }
+        block[NODE_BLOCK_SIZE - 1].nextUsed = nullptr;
 
-        // Link the new node to the list.
-        node->nextUsed = firstNode;
-        firstNode = node;
-    }
-    else
-    {
-        node = cursorNode;
-        cursorNode = cursorNode->nextUsed;
+        if(lastNode) lastNode->nextUsed = block;
+        else         firstNode = block;
+        lastNode   = &block[NODE_BLOCK_SIZE - 1];
+        cursorNode = block;
     }
 
+    Node *node = cursorNode;
+    cursorNode = cursorNode->nextUsed;
+
     node->next = nullptr;
     return node;
 }
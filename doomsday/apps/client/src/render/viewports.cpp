@@ -109,6 +109,11 @@ void R_ResetFrameCount()
     frameCount = 0;
 }
 
+void R_IncrementFrameCount()
+{
+    frameCount++;
+}
+
 #undef R_SetViewOrigin
 DENG_EXTERN_C void R_SetViewOrigin(dint consoleNum, coord_t const origin[3])
 {
@@ -34,11 +34,56 @@
 
 #include "Face"
 
+#include <QHash>
+#include <QVarLengthArray>
 #include <QtAlgorithms>
 
 using namespace de;
 using namespace world;
 
+namespace {
+
+/**
+ * Results of evaluating a wall edge that only depend on the planes and surfaces
+ * around the edge's vertex: the divisions made by neighboring planes and the
+ * (possibly smoothed) normal. These remain valid until the geometry of one of the
+ * subsectors around the vertex changes.
+ */
+struct CachedEdge
+{
+    coord_t lo = 0;
+    coord_t hi = 0;
+    WallSpec::Flags flags;
+    duint stamp = 0;
+
+    bool haveDivisions = false;
+    QVarLengthArray<ddouble, 4> divisions;
+
+    bool haveNormal = false;
+    Vector3f normal;
+};
+
+struct CachedEdgeKey
+{
+    HEdge const *hedge;
+    dint section;
+    dint edge;
+
+    bool operator == (CachedEdgeKey const &other) const
+    {
+        return hedge == other.hedge && section == other.section && edge == other.edge;
+    }
+};
+
+inline uint qHash(CachedEdgeKey const &key)
+{
+    return ::qHash(key.hedge) ^ uint((key.section << 1) | key.edge);
+}
+
+} // namespace
+
+static QHash<CachedEdgeKey, CachedEdge *> edgeCache;
+
 /**
  * Determines whether normal smoothing should be performed for the given pair of
  * map surfaces (which are assumed to share an edge).
@@ -184,6 +229,8 @@ struct WallEdge::Impl : public IHPlane
     Vector3f normal;
     bool needUpdateNormal = true;
 
+    CachedEdge *cached = nullptr; ///< Previous evaluation of this edge (if cacheable).
+
     Impl() {}
 
     void deinit()
@@ -195,6 +242,7 @@ struct WallEdge::Impl : public IHPlane
         events.clear();
         needSortEvents = false;
         needUpdateNormal = true;
+        cached = nullptr;
     }
 
     void init(WallEdge *i, WallSpec const &wallSpec, HEdge &hedge, dint edge)
@@ -438,6 +486,51 @@ struct WallEdge::Impl : public IHPlane
 
         pOrigin    = Vector3d(self->origin(), lo);
         pDirection = Vector3d(0, 0, hi - lo);
+
+        cached = findCachedEdge();
+    }
+
+    /**
+     * Sums the geometry versions of all the subsectors around the edge's vertex.
+     * The sum changes whenever any of them changes.
+     *
+     * @return @c false if the vertex has no line owners.
+     */
+    bool neighborhoodStamp(duint &stamp)
+    {
+        LineSide const &lineSide = lineSideSegment().lineSide();
+        LineOwner const *base = lineSide.line().vertexOwner(lineSide.sideId() ^ edge);
+        if (!base) return false;
+
+        stamp = ClientSubsector::vertexGeometryVersion(*base);
+        return true;
+    }
+
+    CachedEdge *findCachedEdge()
+    {
+        // Polyobjs move freely, so their edges are always evaluated anew.
+        if (lineSideSegment().line().definesPolyobj()) return nullptr;
+
+        duint stamp;
+        if (!neighborhoodStamp(stamp)) return nullptr;
+
+        CachedEdge *&entry = edgeCache[CachedEdgeKey{ wallHEdge, spec.section, edge }];
+        if (!entry)
+        {
+            entry = new CachedEdge;
+        }
+        else if (entry->stamp == stamp && entry->flags == spec.flags
+                 && entry->lo == lo && entry->hi == hi)
+        {
+            return entry; // Still valid.
+        }
+
+        *entry = CachedEdge();
+        entry->lo    = lo;
+        entry->hi    = hi;
+        entry->flags = spec.flags;
+        entry->stamp = stamp;
+        return entry;
     }
 
     inline LineSideSegment &lineSideSegment()
@@ -660,6 +753,17 @@ struct WallEdge::Impl : public IHPlane
         // The first event is the bottom termination event.
         // The last event is the top termination event.
         events.append(bottom);
+
+        if (cached && cached->haveDivisions)
+        {
+            for (ddouble distance : cached->divisions)
+            {
+                events.append(Event(*self, distance));
+            }
+            events.append(top);
+            return;
+        }
+
         events.append(top);
 
         // Add intecepts for neighbor planes?
@@ -679,6 +783,16 @@ struct WallEdge::Impl : public IHPlane
         // Sanity check.
         assertInterceptsInRange(0, 1);
 #endif
+
+        if (cached)
+        {
+            cached->divisions.clear();
+            for (dint i = 1; i < events.size - 1; ++i)
+            {
+                cached->divisions.append(events.at(i).distance());
+            }
+            cached->haveDivisions = true;
+        }
     }
 
     /**
@@ -740,6 +854,12 @@ struct WallEdge::Impl : public IHPlane
     {
         needUpdateNormal = false;
 
+        if (cached && cached->haveNormal)
+        {
+            normal = cached->normal;
+            return;
+        }
+
         LineSide &lineSide = lineSideSegment().lineSide();
         Surface &surface   = lineSide.surface(spec.section);
 
@@ -755,6 +875,12 @@ struct WallEdge::Impl : public IHPlane
         {
             normal = surface.normal();
         }
+
+        if (cached)
+        {
+            cached->normal     = normal;
+            cached->haveNormal = true;
+        }
     }
 };
 
@@ -849,6 +975,12 @@ WallEdge::Event const &WallEdge::last() const
     return d->top;
 }
 
+void WallEdge::clearCache() // static
+{
+    qDeleteAll(edgeCache);
+    edgeCache.clear();
+}
+
 WallEdge::Impl *WallEdge::getRecycledImpl() // static
 {
     if (recycledImpls.isEmpty())
@@ -86,6 +86,7 @@
 #  include "render/rendersystem.h"
 #  include "render/rendpoly.h"
 #  include "MaterialAnimator"
+#  include "WallEdge"
 #  include "ui/progress.h"
 #  include "ui/inputsystem.h"
 #endif
@@ -640,6 +641,7 @@ DENG2_PIMPL(ClientServerWorld)
         Rend_UpdateLightModMatrix();
 
         map->initRadio();
+        map->initReverb();
         map->initContactBlockmaps();
         R_InitContactLists(*map);
         rendSys().worldSystemMapChanged(*map);
@@ -728,6 +730,8 @@ DENG2_PIMPL(ClientServerWorld)
         /// this usage specifically.
 #ifdef __CLIENT__
         R_DestroyContactLists();
+        WallEdge::clearCache();
+        Rend_RadioClearCache();
 #endif
         delete map;
         self().setMap(nullptr);
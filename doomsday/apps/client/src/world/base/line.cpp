@@ -28,6 +28,7 @@
 #include "world/vertex.h"
 #ifdef __CLIENT__
 #  include "world/lineowner.h"
+#  include "client/clientsubsector.h"
 
 #  include "render/r_main.h"  // levelFullBright
 #  include "render/rend_fakeradio.h"
@@ -43,6 +44,7 @@
 #include <QtAlgorithms>
 #include <QList>
 #include <QMap>
+#include <QVarLengthArray>
 #include <array>
 
 #ifdef WIN32
@@ -154,7 +156,7 @@ DENG2_PIMPL(Line::Side)
 
 #ifdef __CLIENT__
     /**
-     * POD: FakeRadio geometry and shadow state.
+     * FakeRadio geometry and shadow state.
      */
     struct RadioData
     {
@@ -163,6 +165,11 @@ DENG2_PIMPL(Line::Side)
         std::array<shadowcorner_t, 2> bottomCorners;  ///< { left, right }
         std::array<shadowcorner_t, 2> sideCorners;    ///< { left, right }
         de::dint updateFrame = 0;
+
+        /// Vertices whose surrounding sectors were examined in the last update.
+        QVarLengthArray<Vertex const *, 8> dependencies;
+        de::duint dependencyVersion = 0;  ///< Geometry version of the dependencies.
+        de::duint version = 0;            ///< Incremented when the data changes.
     };
 #endif
 
@@ -767,6 +774,28 @@ static inline bool sectorIsOpen(Sector const *sector)
     return (sector && sector->ceiling().height() > sector->floor().height());
 }
 
+typedef QVarLengthArray<Vertex const *, 8> RadioDependencies;
+
+static void addRadioDependency(RadioDependencies &deps, Vertex const &vertex)
+{
+    if (!vertex.firstLineOwner()) return;
+    for (Vertex const *dep : deps)
+    {
+        if (dep == &vertex) return;
+    }
+    deps.append(&vertex);
+}
+
+static duint radioDependencyVersion(RadioDependencies const &deps)
+{
+    duint version = 0;
+    for (Vertex const *dep : deps)
+    {
+        version += ClientSubsector::vertexGeometryVersion(*dep->firstLineOwner());
+    }
+    return version;
+}
+
 struct edge_t
 {
     Line *line;
@@ -777,7 +806,8 @@ struct edge_t
 
 /// @todo fixme: Should be rewritten to work at half-edge level.
 /// @todo fixme: Should use the visual plane heights of subsectors.
-static void scanNeighbor(LineSide const &side, bool top, bool right, edge_t &edge)
+static void scanNeighbor(LineSide const &side, bool top, bool right, edge_t &edge,
+                         RadioDependencies &deps)
 {
     static dint const SEP = 10;
 
@@ -805,6 +835,10 @@ static void scanNeighbor(LineSide const &side, bool top, bool right, edge_t &edg
             scanSecSide = (iter->front().sectorPtr() == startSector);
         }
 
+        // The sectors around both ends of the line are examined.
+        addRadioDependency(deps, iter->from());
+        addRadioDependency(deps, iter->to());
+
         // Determine the relative backsector.
         LineSide const &scanSide = iter->side(scanSecSide);
         Sector const *scanSector = scanSide.sectorPtr();
@@ -934,6 +968,8 @@ static void scanNeighbor(LineSide const &side, bool top, bool right, edge_t &edg
         // Since we have the details of the backsector already, simply get the next
         // neighbor (it *is* the back neighbor).
         DENG2_ASSERT(edge.line);
+        addRadioDependency(deps, edge.line->from());
+        addRadioDependency(deps, edge.line->to());
         edge.line = R_FindLineNeighbor(*edge.line,
                                        *edge.line->vertexOwner(dint(edge.line->back().hasSector() && edge.line->back().sectorPtr() == edge.sector) ^ dint(right)),
                                        direction, edge.sector, &edge.diff);
@@ -948,7 +984,8 @@ static void scanNeighbor(LineSide const &side, bool top, bool right, edge_t &edg
  * The length of the top/bottom edges are returned in the array 'spans'.
  *
  * This may look like a complicated operation (performed for all line sides) but in most
- * cases this won't take long. Aligned neighbours are relatively rare.
+ * cases this won't take long. Aligned neighbours are relatively rare. Furthermore, the
+ * results are reused until the geometry around one of the examined vertices changes.
  *
  * @todo fixme: Should use the visual plane heights of subsectors.
  */
@@ -970,6 +1007,15 @@ void Line::Side::updateRadioForFrame(dint frameNumber)
     if (d->radioData.updateFrame == frameNumber) return;
     d->radioData.updateFrame = frameNumber;  // Mark as done.
 
+    // Has anything changed around the examined vertices?
+    RadioDependencies &deps = d->radioData.dependencies;
+    if (!deps.isEmpty() && radioDependencyVersion(deps) == d->radioData.dependencyVersion)
+        return;
+
+    deps.clear();
+    addRadioDependency(deps, from());
+    addRadioDependency(deps, to());
+
     // Process the side corners first.
     d->setRadioCornerSide(false/*left*/, radioCornerOpenness(findSolidLineNeighborAngle(*this, false/*left*/)));
     d->setRadioCornerSide(true/*right*/, radioCornerOpenness(findSolidLineNeighborAngle(*this, true/*right*/)));
@@ -980,8 +1026,8 @@ void Line::Side::updateRadioForFrame(dint frameNumber)
     {
         bool const rightEdge = i != 0;
 
-        edge_t bottom; scanNeighbor(*this, false/*bottom*/, rightEdge, bottom);
-        edge_t top;    scanNeighbor(*this, true/*top*/    , rightEdge, top   );
+        edge_t bottom; scanNeighbor(*this, false/*bottom*/, rightEdge, bottom, deps);
+        edge_t top;    scanNeighbor(*this, true/*top*/    , rightEdge, top   , deps);
 
         d->setRadioEdgeSpan(false/*left*/, rightEdge, line().length() + bottom.length);
         d->setRadioEdgeSpan(true/*right*/, rightEdge, line().length() + top   .length);
@@ -992,6 +1038,14 @@ void Line::Side::updateRadioForFrame(dint frameNumber)
         d->setRadioCornerTop   (rightEdge, radioCornerOpenness(lineNeighborAngle(*this, top   .line, top   .diff)),
                                 top.sector   ? &top   .sector->ceiling() : nullptr);
     }
+
+    d->radioData.dependencyVersion = radioDependencyVersion(deps);
+    d->radioData.version++;
+}
+
+duint Line::Side::radioVersion() const
+{
+    return d->radioData.version;
 }
 #endif  // __CLIENT__
 
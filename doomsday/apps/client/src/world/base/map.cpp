@@ -80,6 +80,9 @@
 
 #include <de/LogBuffer>
 #include <de/Rectangle>
+#ifdef __CLIENT__
+#  include <de/TaskPool>
+#endif
 
 #include <de/aabox.h>
 #include <de/charsymbols.h>
@@ -1923,6 +1926,44 @@ void Map::initRadio()
     LOGDEV_GL_MSG("Completed in %.2f seconds") << begunAt.since();
 }
 
+void Map::initReverb()
+{
+    LOG_AS("Map::initReverb");
+
+    Time begunAt;
+
+    // Each subspace only updates its own audio environment.
+    QVector<ConvexSubspace *> const &subspaces = d->subspaces;
+    TaskPool::parallelFor(subspaces.size(), [&subspaces] (int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            subspaces.at(i)->updateAudioEnvironment();
+        }
+    }, 256);
+
+    // Subsectors only read the (now current) subspace environments.
+    QVector<ClientSubsector *> subsectors;
+    forAllSectors([&subsectors] (Sector &sector)
+    {
+        return sector.forAllSubsectors([&subsectors] (Subsector &subsec)
+        {
+            subsectors << &subsec.as<ClientSubsector>();
+            return LoopContinue;
+        });
+    });
+    TaskPool::parallelFor(subsectors.size(), [&subsectors] (int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            subsectors.at(i)->updateReverbFromSubspaces();
+        }
+    }, 32);
+
+    LOGDEV_AUDIO_VERBOSE("Calculated reverb for %i subsectors in %.2f seconds")
+            << subsectors.size() << begunAt.since();
+}
+
 void Map::initContactBlockmaps()
 {
     d->initContactBlockmaps();
@@ -3334,17 +3375,23 @@ void Map::worldSystemFrameBegins(bool resetNextViewer)
         // Generate surface decorations for the frame.
         if (useLightDecorations)
         {
+            // Perform scheduled redecoration.
             for (Sector *sector : d->sectors)
             {
                 sector->forAllSubsectors([] (Subsector &ssec)
                 {
-                    auto &clSubsector = ssec.as<ClientSubsector>();
-
-                    // Perform scheduled redecoration.
-                    clSubsector.decorate();
+                    ssec.as<ClientSubsector>().decorate();
+                    return LoopContinue;
+                });
+            }
+            ClientSubsector::plotQueuedDecorations();
 
-                    // Generate lumobjs for all decorations who want them.
-                    clSubsector.generateLumobjs();
+            // Generate lumobjs for all decorations who want them.
+            for (Sector *sector : d->sectors)
+            {
+                sector->forAllSubsectors([] (Subsector &ssec)
+                {
+                    ssec.as<ClientSubsector>().generateLumobjs();
                     return LoopContinue;
                 });
             }
@@ -195,7 +195,7 @@ DENG_EXTERN_C void Mobj_SetState(mobj_t *mob, int statenum)
 
     if (!(mob->ddFlags & DDMF_REMOTE))
     {
-        String const exec = DED_Definitions()->states[statenum].gets("execute");
+        String const exec = DED_Definitions()->stateValues(statenum).execute;
         if (!exec.isEmpty())
         {
             Con_Execute(CMDS_SCRIPT, exec.toUtf8(), true, false);
@@ -270,6 +270,11 @@ DENG_EXTERN_C void Mobj_OriginSmoothed(mobj_t *mob, coord_t origin[3])
             Smoother_Evaluate(DD_Player(P_GetDDPlayerIdx(mob->dPlayer))->smoother(), origin);
         }
     }
+    else
+    {
+        // Remote objects are interpolated between the received snapshots.
+        ClMobj_OriginSmoothed(mob, origin);
+    }
 #endif
 }
 
@@ -825,6 +830,12 @@ DENG_EXTERN_C angle_t Mobj_AngleSmoothed(mobj_t *mob)
         }
     }
 
+    angle_t smoothed;
+    if (ClMobj_AngleSmoothed(mob, &smoothed))
+    {
+        return smoothed;
+    }
+
     // Apply a Short Range Visual Offset?
     if (::useSRVOAngle && !::netGame && !::playback)
     {
@@ -35,8 +35,10 @@
 
 #include "world/map.h"
 #include "world/p_object.h"
+#include "misc/tictimings.h"
 
 #include <de/memoryzone.h>
+#include <de/timer.h>
 #include <QList>
 #include <QtAlgorithms>
 
@@ -496,6 +498,8 @@ void Thinker_Run()
     /// @todo fixme: Do not assume the current map.
     if (!App_World().hasMap()) return;
 
+    timespan_t const startedAt = Timer_Seconds();
+
     App_World().map().thinkers().forAll(0x1 | 0x2, [] (thinker_t *th)
     {
         try
@@ -536,6 +540,8 @@ void Thinker_Run()
         }
         return LoopContinue;
     });
+
+    TicTimings_Add(TICTIME_THINKERS, Timer_Seconds() - startedAt);
 }
 
 #undef Thinker_Add
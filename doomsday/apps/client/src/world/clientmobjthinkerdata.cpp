@@ -26,6 +26,7 @@
 #include "render/modelrenderer.h"
 #include "render/stateanimator.h"
 
+#include <de/vector1.h>
 #include <de/RecordValue>
 #include <de/Process>
 #include <QFlags>
@@ -209,6 +210,156 @@ DENG2_PIMPL(ClientMobjThinkerData)
     }
 };
 
+static coord_t const SNAPSHOT_MAX_STEP   = 256;   ///< Farther than this is a teleport.
+static float   const MAX_EXTRAPOLATION   = 0.1f;  ///< Seconds.
+static float   const CORRECTION_DURATION = 0.1f;  ///< Seconds.
+
+typedef ClientMobjThinkerData::RemoteSync RemoteSync;
+
+/**
+ * Finds the snapshots on either side of @a time. If @a time is past the latest
+ * snapshot, both are the latest one.
+ */
+static void findSnapshots(RemoteSync const &sync, float time, int &earlier, int &later)
+{
+    later = earlier = sync.latestSnapshot;
+    if (time >= sync.snapshots[sync.latestSnapshot].time) return;
+
+    for (int n = 1; n < sync.snapshotCount; ++n)
+    {
+        earlier = (later + RemoteSync::SNAPSHOT_COUNT - 1) % RemoteSync::SNAPSHOT_COUNT;
+        if (sync.snapshots[earlier].time <= time) break;
+        later = earlier;
+    }
+}
+
+void ClientMobjThinkerData::RemoteSync::addSnapshot(float time, coord_t const origin[3],
+                                                    coord_t const mom[3], angle_t angle)
+{
+    if (snapshotCount > 0)
+    {
+        Snapshot const &latest = snapshots[latestSnapshot];
+        if (time < latest.time ||
+            Vector3d(origin).distance(Vector3d(latest.origin)) > SNAPSHOT_MAX_STEP)
+        {
+            // Interpolating from the old snapshots would look wrong.
+            clearSnapshots();
+        }
+    }
+
+    // If the object was last drawn at an extrapolated origin, it was likely off.
+    coord_t shownOrigin[3];
+    bool const wasExtrapolated = (snapshotCount > 0 && shown &&
+                                  shownTime > snapshots[latestSnapshot].time &&
+                                  evaluate(shownTime, shownOrigin));
+
+    // Several updates during the same frame replace each other.
+    if (!snapshotCount || snapshots[latestSnapshot].time < time)
+    {
+        latestSnapshot = (snapshotCount > 0? (latestSnapshot + 1) % SNAPSHOT_COUNT : 0);
+        snapshotCount  = de::min(snapshotCount + 1, int(SNAPSHOT_COUNT));
+    }
+
+    Snapshot &snap = snapshots[latestSnapshot];
+    snap.time  = time;
+    snap.angle = angle;
+    for (int i = 0; i < 3; ++i)
+    {
+        snap.origin[i] = origin[i];
+        snap.mom[i]    = mom[i];
+    }
+
+    if (wasExtrapolated)
+    {
+        // Blend out the difference rather than jumping to the correct origin.
+        coord_t corrected[3];
+        V3d_Set(correction, 0, 0, 0);
+        evaluate(shownTime, corrected);
+        V3d_Subtract(correction, shownOrigin, corrected);
+        correctionTime = shownTime;
+    }
+}
+
+void ClientMobjThinkerData::RemoteSync::clearSnapshots()
+{
+    snapshotCount  = 0;
+    latestSnapshot = 0;
+    shown          = false;
+    V3d_Set(correction, 0, 0, 0);
+}
+
+bool ClientMobjThinkerData::RemoteSync::evaluate(float time, coord_t origin[3]) const
+{
+    if (!snapshotCount) return false;
+
+    int earlier, later;
+    findSnapshots(*this, time, earlier, later);
+
+    if (earlier == later)
+    {
+        // Past the latest snapshot: extrapolate for a while using the momentum.
+        Snapshot const &snap = snapshots[later];
+        float const span = de::clamp(0.f, time - snap.time, MAX_EXTRAPOLATION);
+        for (int i = 0; i < 3; ++i)
+        {
+            origin[i] = snap.origin[i] + snap.mom[i] * span * TICSPERSEC;
+        }
+    }
+    else
+    {
+        Snapshot const &a = snapshots[earlier];
+        Snapshot const &b = snapshots[later];
+
+        float const span = b.time - a.time;
+        float const t = (span > 0? de::clamp(0.f, (time - a.time) / span, 1.f) : 1.f);
+        for (int i = 0; i < 3; ++i)
+        {
+            origin[i] = a.origin[i] + (b.origin[i] - a.origin[i]) * t;
+        }
+    }
+
+    // Blend out the remaining correction.
+    float const remaining = 1.f - (time - correctionTime) / CORRECTION_DURATION;
+    if (remaining > 0 && remaining <= 1)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            origin[i] += correction[i] * remaining;
+        }
+    }
+    return true;
+}
+
+bool ClientMobjThinkerData::RemoteSync::evaluateAngle(float time, angle_t *angle) const
+{
+    DENG2_ASSERT(angle);
+    if (!snapshotCount) return false;
+
+    int earlier, later;
+    findSnapshots(*this, time, earlier, later);
+
+    Snapshot const &a = snapshots[earlier];
+    Snapshot const &b = snapshots[later];
+
+    float const span = b.time - a.time;
+    float const t = (span > 0? de::clamp(0.f, (time - a.time) / span, 1.f) : 1.f);
+
+    // Turn along the shorter arc.
+    *angle = a.angle + angle_t(dint32(b.angle - a.angle) * t);
+    return true;
+}
+
+bool ClientMobjThinkerData::RemoteSync::isStale(float time) const
+{
+    return !snapshotCount || time > snapshots[latestSnapshot].time + MAX_EXTRAPOLATION;
+}
+
+void ClientMobjThinkerData::RemoteSync::markShown(float time)
+{
+    shownTime = time;
+    shown     = true;
+}
+
 ClientMobjThinkerData::ClientMobjThinkerData(de::Id const &id)
     : MobjThinkerData(id)
     , d(new Impl(this))
@@ -124,6 +124,30 @@ struct LIBDOOMSDAY_PUBLIC ded_s
     // Composite fonts.
     DEDArray<ded_compositefont_t> compositeFonts;
 
+    /**
+     * Values of a state definition that are needed during gameplay, compiled
+     * into a flat table indexed by state number.
+     */
+    struct CompiledState
+    {
+        de::String action;
+        de::String execute;
+    };
+
+    /**
+     * Values of a thing definition that are needed during gameplay, compiled
+     * into a flat table indexed by thing number.
+     */
+    struct CompiledThing
+    {
+        de::String onTouch;
+        de::String onDeath;
+    };
+
+    std::vector<CompiledState> compiledStates;
+    std::vector<CompiledThing> compiledThings;
+    bool frozen; ///< Set by freeze(), cleared by clear().
+
 public:
     /**
      * Constructor initializes everything to zero.
@@ -209,6 +233,36 @@ public:
      */
     de::String findEpisode(de::String const &mapId) const;
 
+    /**
+     * Compiles the values of the state and thing definitions that are looked up
+     * during gameplay into flat tables, so that they don't need to be looked up
+     * by name from the definition records every tic. Call this once all
+     * definitions have been read. clear() discards the compiled tables, so
+     * after definitions are reloaded they must be frozen again.
+     *
+     * No state or thing definitions may be added while frozen, as the compiled
+     * tables would no longer cover them.
+     */
+    void freeze();
+
+    /**
+     * Determines whether the compiled tables are in use, i.e., freeze() has been
+     * called since the definitions were last cleared.
+     */
+    bool isFrozen() const;
+
+    /**
+     * Returns the compiled values of state @a num. If the definitions have not
+     * been frozen, the values are looked up from the state definition.
+     */
+    CompiledState stateValues(int num) const;
+
+    /**
+     * Returns the compiled values of thing @a num. If the definitions have not
+     * been frozen, the values are looked up from the thing definition.
+     */
+    CompiledThing thingValues(int num) const;
+
 protected:
     void release();
 
@@ -83,6 +83,14 @@ public:
      */
     bool identifyPackages() const;
 
+    /**
+     * Reads the metadata needed for identifying a top-level bundle, either from the
+     * metadata cache or the file contents. This may be called concurrently for
+     * multiple bundles before they are identified with identifyPackages(); nested
+     * bundles are skipped because they depend on their containers.
+     */
+    void prepareIdentification() const;
+
     /**
      * Determines if the data bundle has been identified and now available as a package
      * link.
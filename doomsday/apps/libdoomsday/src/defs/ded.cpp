@@ -113,6 +113,8 @@ int ded_s::addEpisode()
 
 int ded_s::addThing(String const &id)
 {
+    DENG2_ASSERT(!isFrozen()); // Would not be in the compiled table.
+
     Record &def = things.append();
     defn::Thing(def).resetToDefaults();
     def.set(defn::Definition::VAR_ID, id);
@@ -121,6 +123,8 @@ int ded_s::addThing(String const &id)
 
 int ded_s::addState(String const &id)
 {
+    DENG2_ASSERT(!isFrozen()); // Would not be in the compiled table.
+
     Record &def = states.append();
     defn::State(def).resetToDefaults();
     def.set(defn::Definition::VAR_ID, id);
@@ -202,6 +206,10 @@ void ded_s::release()
     lineTypes.clear();
     ptcGens.clear();
     finales.clear();
+
+    compiledStates.clear();
+    compiledThings.clear();
+    frozen = false;
 }
 
 /*
@@ -690,6 +698,58 @@ String ded_s::findEpisode(String const &mapId) const
     return String();
 }
 
+void ded_s::freeze()
+{
+    compiledStates.resize(std::size_t(states.size()));
+    for (int i = 0; i < states.size(); ++i)
+    {
+        Record const &def = states[i];
+        CompiledState &compiled = compiledStates[std::size_t(i)];
+        compiled.action  = def.gets(QStringLiteral("action"));
+        compiled.execute = def.gets(QStringLiteral("execute"));
+    }
+
+    compiledThings.resize(std::size_t(things.size()));
+    for (int i = 0; i < things.size(); ++i)
+    {
+        Record const &def = things[i];
+        CompiledThing &compiled = compiledThings[std::size_t(i)];
+        compiled.onTouch = def.gets(QStringLiteral("onTouch"));
+        compiled.onDeath = def.gets(QStringLiteral("onDeath"));
+    }
+
+    frozen = true;
+}
+
+bool ded_s::isFrozen() const
+{
+    return frozen;
+}
+
+ded_s::CompiledState ded_s::stateValues(int num) const
+{
+    if (num >= 0 && num < int(compiledStates.size()))
+    {
+        return compiledStates[std::size_t(num)];
+    }
+    DENG2_ASSERT(!isFrozen()); // Every state is in the compiled table.
+    Record const &def = states[num];
+    return CompiledState{ def.gets(QStringLiteral("action")),
+                          def.gets(QStringLiteral("execute")) };
+}
+
+ded_s::CompiledThing ded_s::thingValues(int num) const
+{
+    if (num >= 0 && num < int(compiledThings.size()))
+    {
+        return compiledThings[std::size_t(num)];
+    }
+    DENG2_ASSERT(!isFrozen()); // Every thing is in the compiled table.
+    Record const &def = things[num];
+    return CompiledThing{ def.gets(QStringLiteral("onTouch")),
+                          def.gets(QStringLiteral("onDeath")) };
+}
+
 int ded_s::getTextNum(char const *id) const
 {
     if (id && id[0])
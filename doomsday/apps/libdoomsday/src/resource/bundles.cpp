@@ -30,6 +30,8 @@
 
 #include <QList>
 #include <QSet>
+#include <QVector>
+#include <algorithm>
 
 using namespace de;
 
@@ -110,20 +112,60 @@ DENG2_PIMPL(Bundles)
         DENG2_ASSERT(App::rootFolder().has("/sys/bundles"));
 
         bool wasIdentified = false;
-        int  count         = 0;
         Time startedAt;
 
+        QList<DataBundle const *> batch;
         while (auto const *bundle = nextToIdentify())
         {
-            ++count;
-            if (bundle->identifyPackages())
+            batch << bundle;
+        }
+        if (batch.isEmpty()) return false;
+
+        QVector<TimeSpan> durations(batch.size());
+
+        // Reading the file contents (or cached metadata) is the slow part, and it
+        // can be done concurrently for all top-level bundles.
+        TaskPool::parallelFor(batch.size(), [&batch, &durations] (int begin, int end)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                Time const preparedAt;
+                batch.at(i)->prepareIdentification();
+                durations[i] = preparedAt.since();
+            }
+        }, 1);
+
+        // Identification itself is done in order, because nested bundles depend on
+        // their containers and the package links must be unique.
+        for (int i = 0; i < batch.size(); ++i)
+        {
+            Time const identifiedAt;
+            if (batch.at(i)->identifyPackages())
             {
                 wasIdentified = true;
             }
+            durations[i] += identifiedAt.since();
+
+            LOGDEV_RES_VERBOSE("Identified \"%s\" in %i ms")
+                    << batch.at(i)->asFile().path() << durations.at(i).asMilliSeconds();
         }
-        if (count)
+
+        LOG_RES_MSG("Identified %i data bundles in %.1f seconds")
+                << batch.size() << startedAt.since();
+
+        // Which were the slowest ones?
         {
-            LOG_RES_MSG("Identified %i data bundles in %.1f seconds") << count << startedAt.since();
+            QList<int> order;
+            for (int i = 0; i < batch.size(); ++i) order << i;
+            std::sort(order.begin(), order.end(), [&durations] (int a, int b) {
+                return durations.at(a) > durations.at(b);
+            });
+            for (int i = 0; i < de::min(3, order.size()); ++i)
+            {
+                LOG_RES_VERBOSE("Slowest to identify: \"%s\" (%i ms)")
+                        << batch.at(order.at(i))->asFile().path()
+                        << durations.at(order.at(i)).asMilliSeconds();
+            }
         }
         return wasIdentified;
     }
@@ -203,7 +245,8 @@ de::Info const &Bundles::identityRegistry() const
 Bundles::BlockElements Bundles::formatEntries(DataBundle::Format format) const
 {
     d->parseRegistry();
-    return d->formatEntries[format];
+    DENG2_GUARD(d);
+    return d->formatEntries.value(format);
 }
 
 void Bundles::identify()
@@ -81,7 +81,8 @@ DENG2_PIMPL(DataBundle), public Lockable
     Format format;
     String packageId; // linked under /sys/bundles/
     String versionedPackageId;
-    std::unique_ptr<res::LumpDirectory> lumpDir;
+    mutable std::unique_ptr<res::LumpDirectory> lumpDir; // loaded on demand
+    std::unique_ptr<Record> preparedMeta; // read ahead of identification
     SafePtr<LinkFile> pkgLink;
 
     Impl(Public *i, Format fmt) : Base(i), format(fmt)
@@ -98,6 +99,92 @@ DENG2_PIMPL(DataBundle), public Lockable
         return App::rootFolder().locate<Folder>(QStringLiteral("/sys/bundles"));
     }
 
+    bool isWad() const
+    {
+        return format == Wad || format == Pwad || format == Iwad;
+    }
+
+    /**
+     * Loads the lump directory of a WAD file, if it hasn't been loaded yet.
+     *
+     * @return Lump directory, or @c nullptr if the bundle is not a WAD file.
+     */
+    res::LumpDirectory const *loadLumpDirectory() const
+    {
+        DENG2_GUARD(this);
+        if (!lumpDir && isWad())
+        {
+            std::unique_ptr<res::LumpDirectory> dir(
+                        new res::LumpDirectory(source->as<ByteArrayFile>()));
+            if (!dir->isValid())
+            {
+                throw FormatError("DataBundle::identify",
+                                  dynamic_cast<File const *>(thisPublic)->description() +
+                                  ": file contents may be corrupted " DENG2_CHAR_MDASH
+                                  " WAD lump directory was not found");
+            }
+            lumpDir.reset(dir.release());
+        }
+        return lumpDir.get();
+    }
+
+    /// Returns the lump directory, or @c nullptr if it could not be loaded.
+    res::LumpDirectory const *lumpDirectory() const
+    {
+        try
+        {
+            return loadLumpDirectory();
+        }
+        catch (Error const &)
+        {
+            return nullptr;
+        }
+    }
+
+    /**
+     * Determines the WAD type, if unspecified. The lump directory is loaded for
+     * this purpose.
+     */
+    void determineWadType()
+    {
+        if (format == Wad)
+        {
+            format = (loadLumpDirectory()->type() == res::LumpDirectory::Pwad? Pwad : Iwad);
+        }
+    }
+
+    /**
+     * Reads the metadata of a top-level bundle before it gets identified. This
+     * involves the potentially slow reading of the file contents, and it is safe to
+     * do for multiple bundles concurrently.
+     *
+     * Only previously cached metadata is used here. Building new metadata involves
+     * matching against the bundle registry and updating the metadata cache, which
+     * is done serially in identify().
+     */
+    void prepareIdentification()
+    {
+        DENG2_GUARD(this);
+
+        if (ignored || !packageId.isEmpty() || preparedMeta) return;
+
+        // Nested bundles depend on their containers, so they are prepared when
+        // actually identified.
+        if (self().containerBundle() || !self().containerPackageId().isEmpty() ||
+            isAutoLoaded())
+        {
+            return;
+        }
+
+        // If the metadata has been cached, the file contents need not be read at all.
+        // Otherwise, a WAD's lump directory is loaded in advance.
+        preparedMeta = fetchCachedMetadata();
+        if (isWad())
+        {
+            determineWadType();
+        }
+    }
+
     /**
      * Identifies the data bundle and sets up a package link under "/sys/bundles" with
      * the appropriate metadata.
@@ -114,22 +201,19 @@ DENG2_PIMPL(DataBundle), public Lockable
         // It is sufficient to identify each bundle only once.
         if (ignored || !packageId.isEmpty()) return false;
 
-        // Load the lump directory of WAD files.
-        if (format == Wad || format == Pwad || format == Iwad)
+        // The metadata may have already been read.
+        std::unique_ptr<Record> preparedMeta(this->preparedMeta.release());
+
+        if (isWad())
         {
-            // The lump directory needs to be loaded before matching against known
-            // bundles because it can be used for identification.
-            lumpDir.reset(new res::LumpDirectory(source->as<ByteArrayFile>()));
-            if (!lumpDir->isValid())
+            // The WAD type is saved in the metadata cache. Otherwise, the lump
+            // directory needs to be loaded before matching against known bundles
+            // because it can be used for identification.
+            if (!preparedMeta)
             {
-                throw FormatError("DataBundle::identify",
-                                  dynamic_cast<File *>(thisPublic)->description() +
-                                  ": file contents may be corrupted " DENG2_CHAR_MDASH
-                                  " WAD lump directory was not found");
+                preparedMeta = fetchCachedMetadata();
             }
-
-            // Determine the WAD type, if unspecified.
-            format = (lumpDir->type() == res::LumpDirectory::Pwad? Pwad : Iwad);
+            determineWadType();
 
             /*
             qDebug() << self().description()
@@ -193,7 +277,7 @@ DENG2_PIMPL(DataBundle), public Lockable
             }
         }
 
-        Record const meta = cachedMetadata();
+        Record const meta = (preparedMeta? *preparedMeta : cachedMetadata());
         packageId = meta.gets(Package::VAR_ID);
         versionedPackageId = packageId;
 
@@ -270,7 +354,27 @@ DENG2_PIMPL(DataBundle), public Lockable
      */
     Record cachedMetadata()
     {
-        Record meta;
+        if (auto cached = fetchCachedMetadata())
+        {
+            // Well, our work here has already been done.
+            return *cached;
+        }
+
+        Record meta = buildMetadata();
+
+        // Now we can put it in the cache. The WAD type is included so that the lump
+        // directory doesn't need to be read when the cached metadata is used.
+        {
+            Block buf;
+            Writer(buf).withHeader() << meta << dbyte(format);
+            MetadataBank::get().setMetadata(CACHE_CATEGORY, metadataId(), buf.compressed());
+        }
+
+        return meta;
+    }
+
+    Block metadataId() const
+    {
         Block metaId = self().asFile().metaId();
 
         // Include container in the meta ID.
@@ -278,15 +382,36 @@ DENG2_PIMPL(DataBundle), public Lockable
         {
             metaId = Block(metaId + container->asFile().metaId()).md5Hash();
         }
+        return metaId;
+    }
 
+    /**
+     * Checks the metadata bank for previously built metadata. Cache entries are
+     * identified by the status (size, modification time) of the file, so unchanged
+     * files are found without reading their contents.
+     *
+     * @return Cached metadata, or @c nullptr.
+     */
+    std::unique_ptr<Record> fetchCachedMetadata()
+    {
         try
         {
-            // Maybe we already have this?
-            if (Block cached = MetadataBank::get().check(CACHE_CATEGORY, metaId))
+            if (Block cached = MetadataBank::get().check(CACHE_CATEGORY, metadataId()))
             {
-                // Well, our work here has already been done.
                 cached = cached.decompressed();
-                Reader(cached).withHeader() >> meta;
+                std::unique_ptr<Record> meta(new Record);
+                Reader reader(cached);
+                reader.withHeader() >> *meta;
+                if (!reader.atEnd())
+                {
+                    dbyte cachedFormat;
+                    reader >> cachedFormat;
+                    if (format == Wad &&
+                        (cachedFormat == Pwad || cachedFormat == Iwad))
+                    {
+                        format = Format(cachedFormat);
+                    }
+                }
                 return meta;
             }
         }
@@ -294,17 +419,7 @@ DENG2_PIMPL(DataBundle), public Lockable
         {
             LOGDEV_RES_WARNING("Corrupt cached metadata: %s") << er.asText();
         }
-
-        meta = buildMetadata();
-
-        // Now we can put it in the cache.
-        {
-            Block buf;
-            Writer(buf).withHeader() << meta;
-            MetadataBank::get().setMetadata(CACHE_CATEGORY, metaId, buf.compressed());
-        }
-
-        return meta;
+        return nullptr;
     }
 
     Record buildMetadata()
@@ -315,8 +430,10 @@ DENG2_PIMPL(DataBundle), public Lockable
         // Search for known data files in the bundle registry.
         res::Bundles::MatchResult matched = DoomsdayApp::bundles().match(self());
 
-        // Metadata for the package will be collected into this record.
+        // Metadata for the package will be collected into this record. The package
+        // identifier is only assigned when the bundle is identified.
         Record meta;
+        String id;
         meta.set(VAR_PATH,         dataFilePath);
         meta.set(VAR_BUNDLE_SCORE, matched.bestScore);
 
@@ -342,9 +459,9 @@ DENG2_PIMPL(DataBundle), public Lockable
         if (matched)
         {
             // Package metadata has been defined for this file (databundles.dei).
-            packageId = matched.packageId;
+            id = matched.packageId;
 
-            if (lumpDir)
+            if (auto const *lumpDir = loadLumpDirectory())
             {
                 meta.set(QStringLiteral("lumpDirCRC32"), lumpDir->crc32())
                         .value<NumberValue>().setSemanticHints(NumberValue::Hex);
@@ -389,7 +506,7 @@ DENG2_PIMPL(DataBundle), public Lockable
                         stripVersion(dataFilePath.fileNamePath().fileNameWithoutExtension())));
                 }
 
-                packageId = containedId.concatenateMember(packageId);
+                id = containedId.concatenateMember(id);
             }
 
             // The file name may contain a version number.
@@ -407,8 +524,8 @@ DENG2_PIMPL(DataBundle), public Lockable
                          .asDateTime().toString("0.yyyy.MMdd.hhmm"));
             }
 
-            packageId = stripRedundantParts(formatDomains[format]
-                                            .concatenateMember(packageId)
+            id = stripRedundantParts(formatDomains[format]
+                                     .concatenateMember(id)
                                             .concatenateMember(cleanIdentifier(strippedName)));
 
             auto &root = App::rootFolder();
@@ -446,7 +563,7 @@ DENG2_PIMPL(DataBundle), public Lockable
             }
         }
 
-        meta.set("ID", packageId);
+        meta.set("ID", id);
 
         parseNotesForMetadata(meta);
 
@@ -484,7 +601,7 @@ DENG2_PIMPL(DataBundle), public Lockable
                 {
                     for (const auto &spec : masterLevels)
                     {
-                        if (lumpDir->crc32() == spec.crc32 &&
+                        if (loadLumpDirectory()->crc32() == spec.crc32 &&
                             self().asFile().name().compareWithoutCase(spec.filename) == 0)
                         {
                             removeGameTags(meta);
@@ -500,7 +617,7 @@ DENG2_PIMPL(DataBundle), public Lockable
         determineGameTags(meta);
 
         LOG_RES_VERBOSE("Identified \"%s\" %s %s score: %i")
-                << packageId
+                << id
                 << meta.gets(VAR_VERSION)
                 << ::internal::formatDescriptions[format]
                    << meta.geti(VAR_BUNDLE_SCORE); // matched.bestScore;
@@ -1036,6 +1153,7 @@ DENG2_PIMPL(DataBundle), public Lockable
             }
         }*/
 
+        auto const *lumpDir = lumpDirectory();
         res::LumpDirectory::MapType const mapType = lumpDir? lumpDir->mapType()
                                                            : res::LumpDirectory::None;
 
@@ -1281,9 +1399,21 @@ String DataBundle::containerPackageId() const
     return Package::identifierForContainerOfFile(*file);
 }
 
+void DataBundle::prepareIdentification() const
+{
+    try
+    {
+        d->prepareIdentification();
+    }
+    catch (Error const &)
+    {
+        // Problems will be reported when actually identifying.
+    }
+}
+
 res::LumpDirectory const *DataBundle::lumpDirectory() const
 {
-    return d->lumpDir.get();
+    return d->lumpDirectory();
 }
 
 String DataBundle::guessCompatibleGame() const
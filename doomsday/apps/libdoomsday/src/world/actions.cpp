@@ -109,7 +109,7 @@ void P_SetCurrentAction(const String &name)
 
 void P_SetCurrentActionState(int state)
 {
-    P_SetCurrentAction(DED_Definitions()->states[state].gets(QStringLiteral("action")));
+    P_SetCurrentAction(DED_Definitions()->stateValues(state).action);
 }
 
 acfnptr_t P_GetAction(const String &name)
@@ -95,6 +95,22 @@ struct Interpreter
         int delayCount = 0);
 
     static int currentScriptNumber;
+
+    /// Execute the module's pre-decoded instructions (cvar "acs-predecode"). Otherwise
+    /// the p-code is interpreted as is.
+    static byte predecode;
+
+    /**
+     * Execution statistics, collected while profiling (see the "profileacs" command).
+     */
+    struct Profile
+    {
+        bool active = false;
+        de::duint64 thinks = 0;
+        de::duint64 instructions = 0;
+        double seconds = 0;
+    };
+    static Profile profile;
 };
 
 }  // namespace acs
@@ -59,6 +59,37 @@ public:
         de::dint32 scriptArgCount = 0;
     };
 
+    /**
+     * Pre-decoded p-code instruction. The instructions reachable from the entry points
+     * are decoded when the module is loaded, so that operands need not be byte-swapped
+     * and jump offsets resolved every time they are executed. Some common instruction
+     * sequences are fused into a single instruction:
+     *
+     * - PushNumber, PushNumber, and an arithmetic/comparison operator are folded into
+     *   one PushNumber of the result.
+     * - A comparison followed by IfGoto or IfNotGoto becomes a conditional jump.
+     *
+     * Instructions are looked up by their location in the p-code, so the interpreter's
+     * p-code pointer remains meaningful (e.g., in saved games) regardless of how the
+     * code is executed.
+     */
+    struct Instruction
+    {
+        enum FusedOpcode {
+            JumpIfEQ = 1000,
+            JumpIfNE,
+            JumpIfLT,
+            JumpIfGT,
+            JumpIfLE,
+            JumpIfGE
+        };
+
+        de::dint32 opcode = 0;              ///< P-code opcode or a FusedOpcode.
+        de::dint32 size   = 0;              ///< Number of p-code words covered.
+        de::dint32 operands[2] { 0, 0 };    ///< Leading operands, in native byte order.
+        int const *target = nullptr;        ///< Jump target (in the p-code).
+    };
+
 public:
     /**
      * Returns @c true if data @a file appears to be valid ACS code module.
@@ -107,6 +138,14 @@ public:
      */
     de::Block const &pcode() const;
 
+    /**
+     * Looks up the pre-decoded instruction at @a pcodePtr.
+     *
+     * @return Instruction, or @c nullptr if the p-code at this location has not been
+     * decoded and must be interpreted as is.
+     */
+    Instruction const *instruction(int const *pcodePtr) const;
+
 private:
     Module();
 
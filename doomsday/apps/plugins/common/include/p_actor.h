@@ -125,6 +125,9 @@ void P_DeferSpawnMobj3fv(int minTics, mobjtype_t type, coord_t const pos[3], ang
 
 #ifdef __JHEXEN__
 
+/**
+ * Rebuilds the thing ID and type indices from all the mobjs of the map.
+ */
 void P_CreateTIDList(void);
 
 void P_MobjRemoveFromTIDList(mobj_t *mo);
@@ -133,6 +136,29 @@ void P_MobjInsertIntoTIDList(mobj_t *mo, int tid);
 
 mobj_t *P_FindMobjFromTID(int tid, int *searchPosition);
 
+/**
+ * Returns the number of mobjs with thing ID @a tid.
+ */
+int P_MobjCountWithTID(int tid);
+
+void P_MobjInsertIntoTypeIndex(mobj_t *mo);
+
+void P_MobjRemoveFromTypeIndex(mobj_t *mo);
+
+/**
+ * Iterates all the mobjs of a type. Iteration stops when @a callback returns
+ * non-zero.
+ *
+ * @return  Result of the last callback.
+ */
+int P_IterateMobjsOfType(mobjtype_t type, int (*callback) (mobj_t *mo, void *context),
+                         void *context);
+
+/**
+ * Registers the console commands for testing the thing ID and type indices.
+ */
+void P_MobjIndexConsoleRegister(void);
+
 #endif // __JHEXEN__
 
 #ifdef __cplusplus
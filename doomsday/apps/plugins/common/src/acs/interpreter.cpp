@@ -22,6 +22,7 @@
 #include "acs/interpreter.h"
 
 #include <de/Log>
+#include <de/Time>
 #include "acs/system.h"
 #include "dmu_lib.h"
 #include "g_common.h"
@@ -35,6 +36,8 @@
 using namespace de;
 
 int acs::Interpreter::currentScriptNumber = -1;
+byte acs::Interpreter::predecode = true;
+acs::Interpreter::Profile acs::Interpreter::profile;
 
 namespace internal
 {
@@ -46,8 +49,6 @@ namespace internal
         Terminate
     };
 
-    typedef CommandResult (*CommandFunc) (acs::Interpreter &);
-
 /// Helper macro for declaring ACScript command functions.
 #define ACS_COMMAND(Name) CommandResult cmd##Name(acs::Interpreter &interp)
 
@@ -1026,40 +1027,215 @@ namespace internal
         return Continue;
     }
 
-    static CommandFunc const &findCommand(int name)
+    /**
+     * Executes the command identified by @a name. The commands are dispatched with
+     * a switch rather than through a table of function pointers, which allows the
+     * compiler to inline the (mostly trivial) command functions into the
+     * interpreter loop.
+     */
+    static inline CommandResult executeCommand(int name, acs::Interpreter &interp)
     {
-        static CommandFunc const cmds[] =
+        switch(name)
         {
-            cmdNOP, cmdTerminate, cmdSuspend, cmdPushNumber, cmdLSpec1, cmdLSpec2,
-            cmdLSpec3, cmdLSpec4, cmdLSpec5, cmdLSpec1Direct, cmdLSpec2Direct,
-            cmdLSpec3Direct, cmdLSpec4Direct, cmdLSpec5Direct, cmdAdd,
-            cmdSubtract, cmdMultiply, cmdDivide, cmdModulus, cmdEQ, cmdNE,
-            cmdLT, cmdGT, cmdLE, cmdGE, cmdAssignScriptVar, cmdAssignMapVar,
-            cmdAssignWorldVar, cmdPushScriptVar, cmdPushMapVar,
-            cmdPushWorldVar, cmdAddScriptVar, cmdAddMapVar, cmdAddWorldVar,
-            cmdSubScriptVar, cmdSubMapVar, cmdSubWorldVar, cmdMulScriptVar,
-            cmdMulMapVar, cmdMulWorldVar, cmdDivScriptVar, cmdDivMapVar,
-            cmdDivWorldVar, cmdModScriptVar, cmdModMapVar, cmdModWorldVar,
-            cmdIncScriptVar, cmdIncMapVar, cmdIncWorldVar, cmdDecScriptVar,
-            cmdDecMapVar, cmdDecWorldVar, cmdGoto, cmdIfGoto, cmdDrop,
-            cmdDelay, cmdDelayDirect, cmdRandom, cmdRandomDirect,
-            cmdThingCount, cmdThingCountDirect, cmdTagWait, cmdTagWaitDirect,
-            cmdPolyWait, cmdPolyWaitDirect, cmdChangeFloor,
-            cmdChangeFloorDirect, cmdChangeCeiling, cmdChangeCeilingDirect,
-            cmdRestart, cmdAndLogical, cmdOrLogical, cmdAndBitwise,
-            cmdOrBitwise, cmdEorBitwise, cmdNegateLogical, cmdLShift,
-            cmdRShift, cmdUnaryMinus, cmdIfNotGoto, cmdLineSide, cmdScriptWait,
-            cmdScriptWaitDirect, cmdClearLineSpecial, cmdCaseGoto,
-            cmdBeginPrint, cmdEndPrint, cmdPrintString, cmdPrintNumber,
-            cmdPrintCharacter, cmdPlayerCount, cmdGameType, cmdGameSkill,
-            cmdTimer, cmdSectorSound, cmdAmbientSound, cmdSoundSequence,
-            cmdSetLineTexture, cmdSetLineBlocking, cmdSetLineSpecial,
-            cmdThingSound, cmdEndPrintBold
-        };
-        static int const numCmds = sizeof(cmds) / sizeof(cmds[0]);
-        if(name >= 0 && name < numCmds) return cmds[name];
+        case   0: return cmdNOP(interp);
+        case   1: return cmdTerminate(interp);
+        case   2: return cmdSuspend(interp);
+        case   3: return cmdPushNumber(interp);
+        case   4: return cmdLSpec1(interp);
+        case   5: return cmdLSpec2(interp);
+        case   6: return cmdLSpec3(interp);
+        case   7: return cmdLSpec4(interp);
+        case   8: return cmdLSpec5(interp);
+        case   9: return cmdLSpec1Direct(interp);
+        case  10: return cmdLSpec2Direct(interp);
+        case  11: return cmdLSpec3Direct(interp);
+        case  12: return cmdLSpec4Direct(interp);
+        case  13: return cmdLSpec5Direct(interp);
+        case  14: return cmdAdd(interp);
+        case  15: return cmdSubtract(interp);
+        case  16: return cmdMultiply(interp);
+        case  17: return cmdDivide(interp);
+        case  18: return cmdModulus(interp);
+        case  19: return cmdEQ(interp);
+        case  20: return cmdNE(interp);
+        case  21: return cmdLT(interp);
+        case  22: return cmdGT(interp);
+        case  23: return cmdLE(interp);
+        case  24: return cmdGE(interp);
+        case  25: return cmdAssignScriptVar(interp);
+        case  26: return cmdAssignMapVar(interp);
+        case  27: return cmdAssignWorldVar(interp);
+        case  28: return cmdPushScriptVar(interp);
+        case  29: return cmdPushMapVar(interp);
+        case  30: return cmdPushWorldVar(interp);
+        case  31: return cmdAddScriptVar(interp);
+        case  32: return cmdAddMapVar(interp);
+        case  33: return cmdAddWorldVar(interp);
+        case  34: return cmdSubScriptVar(interp);
+        case  35: return cmdSubMapVar(interp);
+        case  36: return cmdSubWorldVar(interp);
+        case  37: return cmdMulScriptVar(interp);
+        case  38: return cmdMulMapVar(interp);
+        case  39: return cmdMulWorldVar(interp);
+        case  40: return cmdDivScriptVar(interp);
+        case  41: return cmdDivMapVar(interp);
+        case  42: return cmdDivWorldVar(interp);
+        case  43: return cmdModScriptVar(interp);
+        case  44: return cmdModMapVar(interp);
+        case  45: return cmdModWorldVar(interp);
+        case  46: return cmdIncScriptVar(interp);
+        case  47: return cmdIncMapVar(interp);
+        case  48: return cmdIncWorldVar(interp);
+        case  49: return cmdDecScriptVar(interp);
+        case  50: return cmdDecMapVar(interp);
+        case  51: return cmdDecWorldVar(interp);
+        case  52: return cmdGoto(interp);
+        case  53: return cmdIfGoto(interp);
+        case  54: return cmdDrop(interp);
+        case  55: return cmdDelay(interp);
+        case  56: return cmdDelayDirect(interp);
+        case  57: return cmdRandom(interp);
+        case  58: return cmdRandomDirect(interp);
+        case  59: return cmdThingCount(interp);
+        case  60: return cmdThingCountDirect(interp);
+        case  61: return cmdTagWait(interp);
+        case  62: return cmdTagWaitDirect(interp);
+        case  63: return cmdPolyWait(interp);
+        case  64: return cmdPolyWaitDirect(interp);
+        case  65: return cmdChangeFloor(interp);
+        case  66: return cmdChangeFloorDirect(interp);
+        case  67: return cmdChangeCeiling(interp);
+        case  68: return cmdChangeCeilingDirect(interp);
+        case  69: return cmdRestart(interp);
+        case  70: return cmdAndLogical(interp);
+        case  71: return cmdOrLogical(interp);
+        case  72: return cmdAndBitwise(interp);
+        case  73: return cmdOrBitwise(interp);
+        case  74: return cmdEorBitwise(interp);
+        case  75: return cmdNegateLogical(interp);
+        case  76: return cmdLShift(interp);
+        case  77: return cmdRShift(interp);
+        case  78: return cmdUnaryMinus(interp);
+        case  79: return cmdIfNotGoto(interp);
+        case  80: return cmdLineSide(interp);
+        case  81: return cmdScriptWait(interp);
+        case  82: return cmdScriptWaitDirect(interp);
+        case  83: return cmdClearLineSpecial(interp);
+        case  84: return cmdCaseGoto(interp);
+        case  85: return cmdBeginPrint(interp);
+        case  86: return cmdEndPrint(interp);
+        case  87: return cmdPrintString(interp);
+        case  88: return cmdPrintNumber(interp);
+        case  89: return cmdPrintCharacter(interp);
+        case  90: return cmdPlayerCount(interp);
+        case  91: return cmdGameType(interp);
+        case  92: return cmdGameSkill(interp);
+        case  93: return cmdTimer(interp);
+        case  94: return cmdSectorSound(interp);
+        case  95: return cmdAmbientSound(interp);
+        case  96: return cmdSoundSequence(interp);
+        case  97: return cmdSetLineTexture(interp);
+        case  98: return cmdSetLineBlocking(interp);
+        case  99: return cmdSetLineSpecial(interp);
+        case 100: return cmdThingSound(interp);
+        case 101: return cmdEndPrintBold(interp);
+        default: break;
+        }
         /// @throw Error  Invalid command name specified.
-        throw Error("acs::Interpreter::findCommand", "Unknown command #" + String::number(name));
+        throw Error("acs::Interpreter::executeCommand", "Unknown command #" + String::number(name));
+    }
+
+    /**
+     * Executes a pre-decoded instruction. The most frequently used commands are
+     * executed here using the decoded operands; the rest are handed over to
+     * executeCommand(), which reads their operands from the p-code.
+     */
+    static inline CommandResult executeInstruction(acs::Module::Instruction const &ins,
+                                                   acs::Interpreter &interp)
+    {
+        using Instruction = acs::Module::Instruction;
+
+        auto &locals = interp.locals;
+        int const var = ins.operands[0];
+
+        switch(ins.opcode)
+        {
+        case  3: locals.push(ins.operands[0]); break; // PushNumber (maybe folded)
+
+        case 25: interp.args[var] = locals.pop(); break;
+        case 26: interp.scriptSys().mapVars[var] = locals.pop(); break;
+        case 27: interp.scriptSys().worldVars[var] = locals.pop(); break;
+        case 28: locals.push(interp.args[var]); break;
+        case 29: locals.push(interp.scriptSys().mapVars[var]); break;
+        case 30: locals.push(interp.scriptSys().worldVars[var]); break;
+        case 31: interp.args[var] += locals.pop(); break;
+        case 32: interp.scriptSys().mapVars[var] += locals.pop(); break;
+        case 34: interp.args[var] -= locals.pop(); break;
+        case 35: interp.scriptSys().mapVars[var] -= locals.pop(); break;
+        case 46: interp.args[var]++; break;
+        case 47: interp.scriptSys().mapVars[var]++; break;
+        case 48: interp.scriptSys().worldVars[var]++; break;
+        case 49: interp.args[var]--; break;
+        case 50: interp.scriptSys().mapVars[var]--; break;
+        case 51: interp.scriptSys().worldVars[var]--; break;
+
+        case 52: // Goto
+            interp.pcodePtr = ins.target;
+            return Continue;
+
+        case 53: // IfGoto
+            interp.pcodePtr = (locals.pop()? ins.target : interp.pcodePtr + ins.size);
+            return Continue;
+
+        case 79: // IfNotGoto
+            interp.pcodePtr = (locals.pop()? interp.pcodePtr + ins.size : ins.target);
+            return Continue;
+
+        case 84: // CaseGoto
+            if(locals.top() == ins.operands[0])
+            {
+                locals.drop();
+                interp.pcodePtr = ins.target;
+            }
+            else
+            {
+                interp.pcodePtr += ins.size;
+            }
+            return Continue;
+
+        case 56: // DelayDirect
+            interp.delayCount = ins.operands[0];
+            interp.pcodePtr += ins.size;
+            return Stop;
+
+        case Instruction::JumpIfEQ:
+        case Instruction::JumpIfNE:
+        case Instruction::JumpIfLT:
+        case Instruction::JumpIfGT:
+        case Instruction::JumpIfLE:
+        case Instruction::JumpIfGE: {
+            int const b = locals.pop();
+            int const a = locals.pop();
+            bool cond;
+            switch(ins.opcode)
+            {
+            case Instruction::JumpIfEQ: cond = (a == b); break;
+            case Instruction::JumpIfNE: cond = (a != b); break;
+            case Instruction::JumpIfLT: cond = (a <  b); break;
+            case Instruction::JumpIfGT: cond = (a >  b); break;
+            case Instruction::JumpIfLE: cond = (a <= b); break;
+            default:                    cond = (a >= b); break;
+            }
+            interp.pcodePtr = (cond? ins.target : interp.pcodePtr + ins.size);
+            return Continue; }
+
+        default:
+            // Interpret the p-code.
+            interp.pcodePtr++;
+            return executeCommand(ins.opcode, interp);
+        }
+        interp.pcodePtr += ins.size;
+        return Continue;
     }
 
 #endif  // __JHEXEN__
@@ -1111,8 +1287,37 @@ void Interpreter::think()
 
         currentScriptNumber = script().entryPoint().scriptNumber;
 
-        while((action = findCommand(DD_LONG(*pcodePtr++))(*this)) == Continue)
-        {}
+        Time const startedAt;
+        duint64 count = 0;
+        if(predecode)
+        {
+            Module const &module = scriptSys().module();
+            do
+            {
+                ++count;
+                if(Module::Instruction const *ins = module.instruction(pcodePtr))
+                {
+                    action = executeInstruction(*ins, *this);
+                }
+                else
+                {
+                    action = executeCommand(DD_LONG(*pcodePtr++), *this);
+                }
+            } while(action == Continue);
+        }
+        else
+        {
+            do
+            {
+                ++count;
+            } while((action = executeCommand(DD_LONG(*pcodePtr++), *this)) == Continue);
+        }
+        if(profile.active)
+        {
+            profile.thinks++;
+            profile.instructions += count;
+            profile.seconds += startedAt.since();
+        }
 
         currentScriptNumber = -1;
     }
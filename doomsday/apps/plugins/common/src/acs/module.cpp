@@ -39,6 +39,7 @@ DENG2_PIMPL_NOREF(Module)
     QVector<EntryPoint> entryPoints;
     QMap<int, EntryPoint *> epByScriptNumberLut;
     QList<String> constants;
+    QVector<Instruction> instructions;  ///< Indexed by p-code word.
 
     void buildEntryPointLut()
     {
@@ -48,6 +49,179 @@ DENG2_PIMPL_NOREF(Module)
             epByScriptNumberLut.insert(ep.scriptNumber, &ep);
         }
     }
+
+    /**
+     * Returns the number of operands following @a opcode in the p-code, or -1 if
+     * the opcode is unknown.
+     */
+    static int operandCount(dint32 opcode)
+    {
+        switch(opcode)
+        {
+        case  3:                            // PushNumber
+        case  4: case  5: case  6: case  7: // LSpec1..5
+        case  8:
+        case 52: case 53: case 56: case 62: // Goto, IfGoto, DelayDirect, TagWaitDirect
+        case 64: case 79: case 82:          // PolyWaitDirect, IfNotGoto, ScriptWaitDirect
+            return 1;
+
+        case  9: case 10: case 11: case 12: // LSpec1..5Direct
+        case 13:
+            return opcode - 7;
+
+        case 58: case 60: case 66: case 68: // RandomDirect, ThingCountDirect,
+        case 84:                            // Change(Floor|Ceiling)Direct, CaseGoto
+            return 2;
+
+        default:
+            if(opcode >= 25 && opcode <= 51) return 1; // Script/map/world variables.
+            if(opcode >= 0 && opcode <= 101) return 0;
+            return -1;
+        }
+    }
+
+    inline dint32 word(int pos) const
+    {
+        return DD_LONG(reinterpret_cast<dint32 const *>(pcode.constData())[pos]);
+    }
+
+    /// Returns the p-code word index of byte @a offset, or -1 if it isn't an
+    /// instruction location.
+    int wordIndex(dint32 offset) const
+    {
+        if(offset < 0 || offset % 4 || offset / 4 >= instructions.size()) return -1;
+        return offset / 4;
+    }
+
+    /**
+     * Decodes all the instructions reachable from the entry points.
+     */
+    void decode()
+    {
+        instructions.clear();
+        instructions.resize(int(pcode.size() / 4));
+
+        QList<int> pending;
+        for(EntryPoint const &ep : entryPoints)
+        {
+            pending << wordIndex(dint32((dbyte const *) ep.pcodePtr - (dbyte const *) pcode.constData()));
+        }
+        while(!pending.isEmpty())
+        {
+            int pos = pending.takeLast();
+            while(pos >= 0 && pos < instructions.size() && !instructions[pos].size)
+            {
+                dint32 const opcode = word(pos);
+                int const count     = operandCount(opcode);
+                if(count < 0 || pos + count >= instructions.size())
+                {
+                    break; // Left for the interpreter to deal with.
+                }
+
+                Instruction ins;
+                ins.opcode = opcode;
+                ins.size   = 1 + count;
+                for(int i = 0; i < de::min(count, 2); ++i)
+                {
+                    ins.operands[i] = word(pos + 1 + i);
+                }
+                if(opcode == 52 || opcode == 53 || opcode == 79 || opcode == 84)
+                {
+                    // The jump offset is the last operand.
+                    int const target = wordIndex(word(pos + count));
+                    if(target < 0) break;
+                    ins.target = reinterpret_cast<int const *>(pcode.constData()) + target;
+                    pending << target;
+                }
+                instructions[pos] = ins;
+
+                // Terminate, Goto, and Restart never continue to the next instruction.
+                if(opcode == 1 || opcode == 52 || opcode == 69) break;
+
+                pos += ins.size;
+            }
+        }
+
+        fuseSequences();
+    }
+
+    Instruction const *decoded(int pos) const
+    {
+        if(pos < 0 || pos >= instructions.size() || !instructions[pos].size) return nullptr;
+        return &instructions[pos];
+    }
+
+    static bool foldOperator(dint32 opcode, dint32 a, dint32 b, dint32 &result)
+    {
+        switch(opcode)
+        {
+        case 14: result = a + b;  return true;
+        case 15: result = a - b;  return true;
+        case 16: result = a * b;  return true;
+        case 17: if(!b) return false; result = a / b; return true;
+        case 18: if(!b) return false; result = a % b; return true;
+        case 19: result = a == b; return true;
+        case 20: result = a != b; return true;
+        case 21: result = a < b;  return true;
+        case 22: result = a > b;  return true;
+        case 23: result = a <= b; return true;
+        case 24: result = a >= b; return true;
+        case 72: result = a & b;  return true;
+        case 73: result = a | b;  return true;
+        case 74: result = a ^ b;  return true;
+        case 76: result = a << b; return true;
+        case 77: result = a >> b; return true;
+        default: return false;
+        }
+    }
+
+    /**
+     * Replaces common instruction sequences with fused instructions. Each fused
+     * instruction is stored at the location of the first instruction of the sequence,
+     * while the rest of the sequence stays decoded as is, in case something jumps
+     * into the middle of it.
+     */
+    void fuseSequences()
+    {
+        // Comparison => conditional jump if true, if false.
+        static dint32 const jumps[6][2] = {
+            { Instruction::JumpIfEQ, Instruction::JumpIfNE },
+            { Instruction::JumpIfNE, Instruction::JumpIfEQ },
+            { Instruction::JumpIfLT, Instruction::JumpIfGE },
+            { Instruction::JumpIfGT, Instruction::JumpIfLE },
+            { Instruction::JumpIfLE, Instruction::JumpIfGT },
+            { Instruction::JumpIfGE, Instruction::JumpIfLT },
+        };
+
+        for(int pos = 0; pos < instructions.size(); ++pos)
+        {
+            Instruction &ins = instructions[pos];
+            if(!ins.size) continue;
+
+            if(ins.opcode == 3) // PushNumber
+            {
+                auto const *second = decoded(pos + 2);
+                auto const *op     = decoded(pos + 4);
+                dint32 result;
+                if(second && second->opcode == 3 && op && op->size == 1 &&
+                   foldOperator(op->opcode, ins.operands[0], second->operands[0], result))
+                {
+                    ins.operands[0] = result;
+                    ins.size        = 5;
+                }
+            }
+            else if(ins.opcode >= 19 && ins.opcode <= 24) // EQ..GE
+            {
+                auto const *branch = decoded(pos + 1);
+                if(branch && (branch->opcode == 53 || branch->opcode == 79)) // IfGoto, IfNotGoto
+                {
+                    ins.opcode = jumps[ins.opcode - 19][branch->opcode == 53? 0 : 1];
+                    ins.target = branch->target;
+                    ins.size   = 1 + branch->size;
+                }
+            }
+        }
+    }
 };
 
 Module::Module() : d(new Impl)
@@ -140,6 +314,8 @@ Module *Module::newFromBytecode(Block const &bytecode)  // static
         module->d->constants << String::fromUtf8(utf);
     }
 
+    module->d->decode();
+
     return module.release();
 }
 
@@ -199,4 +375,9 @@ Block const &Module::pcode() const
     return d->pcode;
 }
 
+Module::Instruction const *Module::instruction(int const *pcodePtr) const
+{
+    return d->decoded(int(pcodePtr - reinterpret_cast<int const *>(d->pcode.constData())));
+}
+
 } // namespace acs
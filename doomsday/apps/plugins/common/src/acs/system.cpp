@@ -24,6 +24,7 @@
 #include <de/ISerializable>
 #include <de/Log>
 #include <de/NativePath>
+#include "acs/interpreter.h"
 #include "acs/module.h"
 #include "acs/script.h"
 #include "gamesession.h"
@@ -393,12 +394,40 @@ D_CMD(ListACScripts)
     return true;
 }
 
+D_CMD(ProfileACScripts)
+{
+    DENG2_UNUSED3(src, argc, argv);
+    auto &profile = Interpreter::profile;
+
+    if(!profile.active)
+    {
+        profile = Interpreter::Profile();
+        profile.active = true;
+        LOG_SCR_MSG("Profiling ACScript execution (%s); "
+                    "enter \"profileacs\" again to see the results")
+                << (Interpreter::predecode? "pre-decoded" : "p-code");
+        return true;
+    }
+
+    profile.active = false;
+    LOG_SCR_MSG("ACScripts ran %i times, executing %i instructions in %.3f ms "
+                "(%.1f ns per instruction)")
+            << profile.thinks
+            << profile.instructions
+            << profile.seconds * 1000
+            << (profile.instructions? profile.seconds * 1.0e9 / profile.instructions : 0.0);
+    return true;
+}
+
 void System::consoleRegister()  // static
 {
+    C_VAR_BYTE("acs-predecode",         &Interpreter::predecode, 0, 0, 1);
+
     C_CMD("inspectacscript",        "i", InspectACScript);
     /* Alias */ C_CMD("scriptinfo", "i", InspectACScript);
     C_CMD("listacscripts",          "",  ListACScripts);
     /* Alias */ C_CMD("scriptinfo", "",  ListACScripts);
+    C_CMD("profileacs",             "",  ProfileACScripts);
 }
 
 }  // namespace acs
@@ -364,6 +364,9 @@ void G_CommonPreInit()
 #if __JDOOM__ || __JDOOM64__ || __JHERETIC__
     XG_Register();
 #endif
+#if __JHEXEN__
+    P_MobjIndexConsoleRegister();
+#endif
 
     Con_SetString2("map-author", "Unknown", SVF_WRITE_OVERRIDE);
     Con_SetString2("map-name",   "Unknown", SVF_WRITE_OVERRIDE);
@@ -444,7 +444,7 @@ dd_bool P_MobjChangeStateNoAction(mobj_t *mobj, statenum_t stateNum)
 }
 
 #if __JHEXEN__
-# define MOBJ_SAVEVERSION 8
+# define MOBJ_SAVEVERSION 9
 #elif __JHERETIC__
 # define MOBJ_SAVEVERSION 10
 #else
@@ -487,6 +487,7 @@ void mobj_s::write(MapStateWriter *msw) const
     // JHEXEN
     // 7: Removed superfluous info ptr
     // 8: Added 'onMobj'
+    // 9: Thing ID search positions index the list of the thing ID
     Writer_WriteByte(writer, MOBJ_SAVEVERSION);
 
 #if !__JHEXEN__
@@ -758,6 +759,12 @@ int mobj_s::read(MapStateReader *msr)
     }
     special1     = Reader_ReadInt32(reader);
     special2     = Reader_ReadInt32(reader);
+    if(ver < 9 && type == MT_KORAX)
+    {
+        // Korax's teleport spot search position is meaningless in the current
+        // thing ID index; restart the search.
+        special1 = -1;
+    }
 #endif
     health       = Reader_ReadInt32(reader);
 
@@ -1165,8 +1172,7 @@ void Mobj_RunScriptOnDeath(mobj_t *mob, mobj_t *killer)
     }
 
     // Check Thing definition for an onDeath script.
-    const auto &thingDef = DED_Definitions()->things[mob->type];
-    if (const String onDeathSrc = thingDef.gets(QStringLiteral("onDeath")))
+    if (const String onDeathSrc = DED_Definitions()->thingValues(mob->type).onDeath)
     {
         LOG_AS("Mobj_RunScriptOnDeath");
 
@@ -1201,8 +1207,7 @@ dd_bool Mobj_RunScriptOnTouch(mobj_t *mob, mobj_t *special, enum mobjtouchresult
     }
 
     // Check Thing definition for an onTouch script.
-    const auto &thingDef = DED_Definitions()->things[special->type];
-    if (const String onTouchSrc = thingDef.gets(QStringLiteral("onTouch")))
+    if (const String onTouchSrc = DED_Definitions()->thingValues(special->type).onTouch)
     {
         LOG_AS("Mobj_RunScriptOnTouch");
 
@@ -20,6 +20,9 @@
 
 #include <cstdio>
 #include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <de/Time>
 
 #include "common.h"
 #include "gamesession.h"
@@ -111,6 +114,9 @@ void P_MobjRemove(mobj_t *mo, dd_bool noRespawn)
 #endif
 
 justDoIt:
+#if __JHEXEN__
+    P_MobjRemoveFromTypeIndex(mo);
+#endif
     Mobj_Destroy(mo);
 }
 
@@ -489,71 +495,106 @@ void P_PurgeDeferredSpawns()
 
 #ifdef __JHEXEN__
 
-/// @todo Remove fixed limit.
-#define MAX_TID_COUNT           200
+/**
+ * Index of mobjs by a key (thing ID or type). Each key has its own list of mobjs.
+ * A removed mobj leaves an empty slot in the list, which is reused by a later
+ * insertion, so that positions in a list remain valid while it is being iterated.
+ */
+class MobjIndex
+{
+public:
+    struct List
+    {
+        std::vector<mobj_t *> slots;
+        std::vector<int> freeSlots;
+        int count = 0; ///< Number of mobjs in the list.
+    };
+
+    void clear()
+    {
+        _lists.clear();
+        _positions.clear();
+    }
+
+    void insert(int key, mobj_t *mo)
+    {
+        // The same address may have been used by a mobj that no longer exists.
+        remove(mo);
+
+        List &list = _lists[key];
+        int slot;
+        if (!list.freeSlots.empty())
+        {
+            slot = list.freeSlots.back();
+            list.freeSlots.pop_back();
+            list.slots[slot] = mo;
+        }
+        else
+        {
+            slot = int(list.slots.size());
+            list.slots.push_back(mo);
+        }
+        list.count++;
+        _positions[mo] = Position{ key, slot };
+    }
+
+    void remove(mobj_t const *mo)
+    {
+        auto found = _positions.find(mo);
+        if (found == _positions.end()) return;
+
+        List &list = _lists[found->second.key];
+        list.slots[found->second.slot] = nullptr;
+        list.freeSlots.push_back(found->second.slot);
+        list.count--;
+        _positions.erase(found);
+    }
 
-static int TIDList[MAX_TID_COUNT + 1];  // +1 for termination marker
-static mobj_t *TIDMobj[MAX_TID_COUNT];
+    List const *list(int key) const
+    {
+        auto found = _lists.find(key);
+        return found != _lists.end()? &found->second : nullptr;
+    }
+
+private:
+    struct Position
+    {
+        int key;
+        int slot;
+    };
+    std::unordered_map<int, List> _lists;
+    std::unordered_map<mobj_t const *, Position> _positions;
+};
+
+static MobjIndex tidIndex;
+static MobjIndex typeIndex;
 
-static int insertThinkerInIdListWorker(thinker_t *th, void *context)
+static int insertThinkerInIndexWorker(thinker_t *th, void *)
 {
     mobj_t *mo = (mobj_t *)th;
-    int *count = (int *) context;
 
     if(mo->tid != 0)
     {
-        // Add to list.
-        if(*count == MAX_TID_COUNT)
-        {
-            Con_Error("P_CreateTIDList: MAX_TID_COUNT (%d) exceeded.", MAX_TID_COUNT);
-        }
-
-        TIDList[*count] = mo->tid;
-        TIDMobj[(*count)++] = mo;
+        tidIndex.insert(mo->tid, mo);
     }
+    typeIndex.insert(mo->type, mo);
 
     return false; // Continue iteration.
 }
 
 void P_CreateTIDList()
 {
-    int count = 0;
-    Thinker_Iterate(P_MobjThinker, insertThinkerInIdListWorker, &count);
-
-    // Add termination marker
-    TIDList[count] = 0;
+    tidIndex.clear();
+    typeIndex.clear();
+    Thinker_Iterate(P_MobjThinker, insertThinkerInIndexWorker, nullptr);
 }
 
 void P_MobjInsertIntoTIDList(mobj_t *mo, int tid)
 {
     DENG_ASSERT(mo != 0);
 
-    int index = -1;
-    int i = 0;
-    for(; TIDList[i] != 0; ++i)
-    {
-        if(TIDList[i] == -1)
-        {
-            // Found empty slot
-            index = i;
-            break;
-        }
-    }
-
-    if(index == -1)
-    {
-        // Append required
-        if(i == MAX_TID_COUNT)
-        {
-            Con_Error("P_MobjInsertIntoTIDList: MAX_TID_COUNT (%d) exceeded.", MAX_TID_COUNT);
-        }
-        index = i;
-        TIDList[index + 1] = 0;
-    }
-
     mo->tid = tid;
-    TIDList[index] = tid;
-    TIDMobj[index] = mo;
+    tidIndex.insert(tid, mo);
 }
 
 void P_MobjRemoveFromTIDList(mobj_t *mo)
@@ -561,35 +602,188 @@ void P_MobjRemoveFromTIDList(mobj_t *mo)
     if(!mo || !mo->tid)
         return;
 
-    for(int i = 0; TIDList[i] != 0; ++i)
+    tidIndex.remove(mo);
+    mo->tid = 0;
+}
+
+/**
+ * Finds the next mobj with @a key after @a searchPosition, which is an index to
+ * the list of the key (-1 to start from the beginning).
+ */
+static mobj_t *findNextInIndex(MobjIndex const &index, int key, int *searchPosition)
+{
+    if(MobjIndex::List const *list = index.list(key))
     {
-        if(TIDMobj[i] == mo)
+        for(int i = (*searchPosition < 0? 0 : *searchPosition + 1); i < int(list->slots.size()); ++i)
         {
-            TIDList[i] = -1;
-            TIDMobj[i] = 0;
-            mo->tid = 0;
-            return;
+            if(list->slots[i])
+            {
+                *searchPosition = i;
+                return list->slots[i];
+            }
         }
     }
 
-    mo->tid = 0;
+    *searchPosition = -1;
+    return 0;
 }
 
 mobj_t *P_FindMobjFromTID(int tid, int *searchPosition)
 {
     DENG_ASSERT(searchPosition != 0);
+    return findNextInIndex(tidIndex, tid, searchPosition);
+}
+
+int P_MobjCountWithTID(int tid)
+{
+    MobjIndex::List const *list = tidIndex.list(tid);
+    return list? list->count : 0;
+}
 
-    for(int i = *searchPosition + 1; TIDList[i] != 0; ++i)
+void P_MobjInsertIntoTypeIndex(mobj_t *mo)
+{
+    DENG_ASSERT(mo != 0);
+    typeIndex.insert(mo->type, mo);
+}
+
+void P_MobjRemoveFromTypeIndex(mobj_t *mo)
+{
+    typeIndex.remove(mo);
+}
+
+int P_IterateMobjsOfType(mobjtype_t type, int (*callback) (mobj_t *mo, void *context),
+                         void *context)
+{
+    if(MobjIndex::List const *list = typeIndex.list(type))
     {
-        if(TIDList[i] == tid)
+        // The callback may remove mobjs; removal leaves the slots in place.
+        for(std::size_t i = 0; i < list->slots.size(); ++i)
         {
-            *searchPosition = i;
-            return TIDMobj[i];
+            if(mobj_t *mo = list->slots[i])
+            {
+                if(int result = callback(mo, context)) return result;
+            }
         }
     }
+    return false;
+}
+
+/**
+ * Stress tests a separate MobjIndex with a large number of tagged mobjs (the ones
+ * of the current map are not affected). The results are checked against a simple
+ * count of mobjs per key.
+ */
+D_CMD(TestMobjIndex)
+{
+    DENG2_UNUSED(src);
+    using namespace de;
+
+    int const count = (argc > 1? String(argv[1]).toInt() : 50000);
+    if(count < 1)
+    {
+        LOG_SCR_ERROR("Invalid number of mobjs %i") << count;
+        return false;
+    }
+    int const keyCount = de::max(1, count / 16);
 
-    *searchPosition = -1;
-    return 0;
+    std::vector<mobj_t> mobjs(count);
+    std::vector<int> keys(count);
+    std::unordered_map<int, int> expected;
+    MobjIndex index;
+    int errors = 0;
+
+    // Checks that the mobjs found for each key are the expected ones.
+    auto verify = [&] ()
+    {
+        for(int key = 1; key <= keyCount; ++key)
+        {
+            int found = 0;
+            int pos = -1;
+            while(mobj_t *mo = findNextInIndex(index, key, &pos))
+            {
+                if(keys[mo - &mobjs[0]] != key) errors++;
+                found++;
+            }
+            MobjIndex::List const *list = index.list(key);
+            if(found != expected[key] || (list? list->count : 0) != found) errors++;
+        }
+    };
+
+    Time startedAt;
+    for(int i = 0; i < count; ++i)
+    {
+        keys[i] = 1 + (i * 7919) % keyCount;
+        index.insert(keys[i], &mobjs[i]);
+        expected[keys[i]]++;
+    }
+    TimeSpan const insertTime = startedAt.since();
+
+    startedAt = Time();
+    verify();
+    TimeSpan const findTime = startedAt.since();
+
+    // Remove every third mobj while iterating, as Thing_Remove does.
+    startedAt = Time();
+    int removed = 0;
+    for(int key = 1; key <= keyCount; ++key)
+    {
+        int visited = 0;
+        int pos = -1;
+        while(mobj_t *mo = findNextInIndex(index, key, &pos))
+        {
+            if(visited++ % 3 == 0)
+            {
+                index.remove(mo);
+                keys[mo - &mobjs[0]] = 0;
+                expected[key]--;
+                removed++;
+            }
+        }
+        if(visited != expected[key] + (visited + 2) / 3) errors++;
+    }
+    TimeSpan const removeTime = startedAt.since();
+    verify();
+
+    // Reinsert the removed mobjs under other keys; the empty slots are reused.
+    std::size_t slotCount = 0;
+    for(int key = 1; key <= keyCount; ++key)
+    {
+        if(MobjIndex::List const *list = index.list(key)) slotCount += list->slots.size();
+    }
+    for(int i = 0; i < count; ++i)
+    {
+        if(keys[i]) continue;
+        keys[i] = 1 + (i * 104729) % keyCount;
+        index.insert(keys[i], &mobjs[i]);
+        expected[keys[i]]++;
+    }
+    verify();
+    std::size_t reinsertedSlotCount = 0;
+    for(int key = 1; key <= keyCount; ++key)
+    {
+        if(MobjIndex::List const *list = index.list(key)) reinsertedSlotCount += list->slots.size();
+    }
+
+    LOG_SCR_MSG(_E(b) "Mobj index: %i mobjs, %i keys, %i removed and reinserted")
+            << count << keyCount << removed;
+    LOG_SCR_MSG("  Insert %.3f ms, find all %.3f ms, remove while iterating %.3f ms")
+            << ddouble(insertTime) * 1000 << ddouble(findTime) * 1000
+            << ddouble(removeTime) * 1000;
+    LOG_SCR_MSG("  Slots: %i before reinsertion, %i after")
+            << int(slotCount) << int(reinsertedSlotCount);
+    if(errors)
+    {
+        LOG_SCR_ERROR("Mobj index test failed with %i errors") << errors;
+        return false;
+    }
+    LOG_SCR_MSG("Mobj index test passed");
+    return true;
+}
+
+void P_MobjIndexConsoleRegister()
+{
+    C_CMD("testmobjindex", "",  TestMobjIndex);
+    C_CMD("testmobjindex", "i", TestMobjIndex);
 }
 
 #endif // __JHEXEN__
@@ -3411,10 +3411,9 @@ struct countmobjoftypeparams_t
     int count;
 };
 
-static int countMobjOfType(thinker_t *th, void *context)
+static int countMobjOfType(mobj_t *mo, void *context)
 {
     countmobjoftypeparams_t *params = (countmobjoftypeparams_t *) context;
-    mobj_t *mo = (mobj_t *) th;
 
     // Does the type match?
     if(mo->type != params->type)
@@ -3437,6 +3436,12 @@ int P_MobjCount(int type, int tid)
 
     if(tid)
     {
+        if(type == 0)
+        {
+            // Just count TIDs.
+            return P_MobjCountWithTID(tid);
+        }
+
         // Count mobjs by TID.
         int count = 0;
         mobj_t *mo;
@@ -3444,12 +3449,7 @@ int P_MobjCount(int type, int tid)
 
         while((mo = P_FindMobjFromTID(tid, &searcher)))
         {
-            if(type == 0)
-            {
-                // Just count TIDs.
-                count++;
-            }
-            else if(moType == mo->type)
+            if(moType == mo->type)
             {
                 // Don't count dead monsters.
                 if((mo->flags & MF_COUNTKILL) && mo->health <= 0)
@@ -3466,7 +3466,7 @@ int P_MobjCount(int type, int tid)
     countmobjoftypeparams_t params;
     params.type  = moType;
     params.count = 0;
-    Thinker_Iterate(P_MobjThinker, countMobjOfType, &params);
+    P_IterateMobjsOfType(moType, countMobjOfType, &params);
 
     return params.count;
 }
@@ -1152,6 +1152,7 @@ mobj_t* P_SpawnMobjXYZ(mobjtype_t type, coord_t x, coord_t y, coord_t z,
                       info->height, ddflags);
     mo->type = type;
     mo->info = info;
+    P_MobjInsertIntoTypeIndex(mo);
     mo->flags = info->flags;
     mo->flags2 = info->flags2;
     mo->flags3 = info->flags3;
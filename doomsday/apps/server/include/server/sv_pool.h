@@ -253,8 +253,20 @@ typedef struct pool_s {
     int             queueSize;
     int             allocatedSize;
     delta_t**       queue;
+
+    // Potentially visible set of sectors for the owner's viewpoint. Deltas
+    // of entities outside the set are kept in the pool but not sent until
+    // they become visible. One bit per sector; NULL means everything is
+    // considered visible.
+    byte*           pvs;
+    int             pvsSector; // Sector the set was built for (-1 if none).
+    coord_t         pvsOrigin[2]; // Viewer origin the set was built for.
+    uint            pvsPlaneMoves; // Plane movements already accounted for.
 } pool_t;
 
+/// Interest management: only send deltas of sectors the client may see.
+extern byte netInterest;
+
 void            Sv_InitPools(void);
 void            Sv_ShutdownPools(void);
 void            Sv_DrainPool(uint clientNumber);
@@ -19,6 +19,7 @@
 #include "remotefeeduser.h"
 
 #include <de/Async>
+#include <de/ByteRefArray>
 #include <de/FileSystem>
 #include <de/Folder>
 #include <de/Message>
@@ -26,6 +27,20 @@
 
 using namespace de;
 
+static dsize const MIN_CHUNK_SIZE = 4 * 1024;
+static dsize const MAX_CHUNK_SIZE = 16 * 1024 * 1024;
+
+static int const MAX_CACHED_MANIFESTS = 256;
+
+/// Chunk hashes of recently requested files, shared by all users. Key is the file's
+/// meta ID and chunk size.
+struct ManifestCache
+{
+    QHash<Block, QList<Block>> manifests;
+    QList<Block> usage; ///< Least recently used first.
+};
+static LockableT<ManifestCache> manifestCache;
+
 DENG2_PIMPL(RemoteFeedUser)
 {
     using QueryId = RemoteFeedQueryPacket::Id;
@@ -34,6 +49,7 @@ DENG2_PIMPL(RemoteFeedUser)
     {
         QueryId queryId;
         Block data;
+        duint64 baseOffset = 0; ///< Offset of the data in the file.
         duint64 position = 0;
 
         Transfer(QueryId id = 0) : queryId(id)
@@ -127,7 +143,7 @@ DENG2_PIMPL(RemoteFeedUser)
 
                 response->setId(xfer.queryId);
                 response->setFileSize(xfer.data.size());
-                response->setStartOffset(xfer.position);
+                response->setStartOffset(xfer.baseOffset + xfer.position);
                 response->setData(xfer.data.mid(xfer.position, blockSize));
 
                 xfer.position += response->data().size();
@@ -151,6 +167,67 @@ DENG2_PIMPL(RemoteFeedUser)
         }
     }
 
+    static Block readRange(File const &file, duint64 offset, duint64 size)
+    {
+        if (auto const *bytes = maybeAs<IByteArray>(file.target()))
+        {
+            // Only read the requested part.
+            if (offset >= bytes->size()) return Block();
+            return Block(*bytes, offset, dsize(de::min(size, duint64(bytes->size() - offset))));
+        }
+        Block data;
+        file >> data;
+        return data.mid(int(offset), int(size));
+    }
+
+    static QList<Block> manifest(File const &file, dsize chunkSize)
+    {
+        Block const key = md5Hash(file.metaId(), duint32(chunkSize));
+        {
+            DENG2_GUARD(manifestCache);
+            auto found = manifestCache.value.manifests.constFind(key);
+            if (found != manifestCache.value.manifests.constEnd())
+            {
+                manifestCache.value.usage.removeOne(key);
+                manifestCache.value.usage.append(key);
+                return found.value();
+            }
+        }
+        QList<Block> hashes;
+        if (auto const *bytes = maybeAs<IByteArray>(file.target()))
+        {
+            // Read one chunk at a time so that large files are not loaded in memory.
+            Block chunk;
+            for (dsize pos = 0; pos < bytes->size(); pos += chunkSize)
+            {
+                chunk.resize(de::min(chunkSize, bytes->size() - pos));
+                bytes->get(pos, chunk.data(), chunk.size());
+                hashes << RemoteFeedManifestPacket::chunkHash(chunk);
+            }
+        }
+        else
+        {
+            Block data;
+            file >> data;
+            for (dsize pos = 0; pos < dsize(data.size()); pos += chunkSize)
+            {
+                dsize const len = de::min(chunkSize, dsize(data.size()) - pos);
+                hashes << RemoteFeedManifestPacket::chunkHash(ByteRefArray(data.constData() + pos, len));
+            }
+        }
+        DENG2_GUARD(manifestCache);
+        if (!manifestCache.value.manifests.contains(key))
+        {
+            manifestCache.value.manifests.insert(key, hashes);
+            manifestCache.value.usage.append(key);
+            while (manifestCache.value.usage.size() > MAX_CACHED_MANIFESTS)
+            {
+                manifestCache.value.manifests.remove(manifestCache.value.usage.takeFirst());
+            }
+        }
+        return hashes;
+    }
+
     Packet *handleQueryAsync(RemoteFeedQueryPacket const &query)
     {
         // Note: This is executed in a background thread.
@@ -193,6 +270,39 @@ DENG2_PIMPL(RemoteFeedUser)
                 DENG2_GUARD(transfers);
                 transfers.value.push_back(xfer);
                 break; }
+
+            case RemoteFeedQueryPacket::FileManifest: {
+                std::unique_ptr<RemoteFeedManifestPacket> manifestResponse(new RemoteFeedManifestPacket);
+                manifestResponse->setId(query.id());
+                if (auto const *file = FS::tryLocate<File const>(query.path()))
+                {
+                    dsize const chunkSize = de::clamp(MIN_CHUNK_SIZE, query.chunkSize(), MAX_CHUNK_SIZE);
+                    manifestResponse->setFileSize(file->size());
+                    manifestResponse->setChunkSize(chunkSize);
+                    manifestResponse->setChunkHashes(manifest(*file, chunkSize));
+                }
+                else
+                {
+                    LOG_NET_WARNING("%s not found!") << query.path();
+                }
+                return manifestResponse.release(); }
+
+            case RemoteFeedQueryPacket::FileRange: {
+                Transfer xfer(query.id());
+                xfer.baseOffset = query.rangeOffset();
+                if (auto const *file = FS::tryLocate<File const>(query.path()))
+                {
+                    xfer.data = readRange(*file, query.rangeOffset(), query.rangeSize());
+                }
+                else
+                {
+                    LOG_NET_WARNING("%s not found!") << query.path();
+                }
+                LOG_NET_XVERBOSE("File range transfer: %s offset:%i size:%i",
+                                 query.path() << query.rangeOffset() << xfer.data.size());
+                DENG2_GUARD(transfers);
+                transfers.value.push_back(xfer);
+                break; }
             }
         }
         catch (Error const &er)
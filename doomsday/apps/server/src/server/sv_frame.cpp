@@ -21,11 +21,13 @@
 #include "server/sv_frame.h"
 #include "def_main.h"
 #include "sys_system.h"
+#include "misc/tictimings.h"
 #include "network/net_main.h"
 #include "server/sv_pool.h"
 #include "world/p_players.h"
 
 #include <de/LogBuffer>
+#include <de/timer.h>
 #include <cmath>
 
 using namespace de;
@@ -95,7 +97,9 @@ void Sv_TransmitFrame()
     LOG_AS("Sv_TransmitFrame");
 
     // Generate new deltas for the frame.
+    timespan_t const startedAt = Timer_Seconds();
     Sv_GenerateFrameDeltas();
+    TicTimings_Add(TICTIME_FRAMEDELTAS, Timer_Seconds() - startedAt);
 
     // How many players currently in the game?
     dint const numInGame = Sv_GetNumPlayers();
@@ -25,6 +25,8 @@
 #include "server/sv_pool.h"
 
 #include <cmath>
+#include <cstring>
+#include <memory>
 #include <de/mathutil.h>
 #include <de/timer.h>
 #include <de/vector1.h>
@@ -36,7 +38,11 @@
 #include "world/p_object.h"
 #include "world/p_players.h"
 #include "world/thinkers.h"
+#include "BspLeaf"
+#include "Line"
+#include "Plane"
 #include "Sector"
+#include "Surface"
 
 using namespace de;
 
@@ -48,6 +54,14 @@ using namespace de;
 // Maximum difference in plane height where the absolute height doesn't need to be sent.
 #define PLANE_SKIP_LIMIT            ( 40 )
 
+// Number of frames over which all sides are compared to catch changes that are not
+// journaled (blend modes and side flags).
+#define SIDE_SWEEP_FRAMES           ( 32 )
+
+// Maximum number of portals passed through while building a client's potentially
+// visible set. If exceeded, everything is considered visible.
+#define PVS_MAX_PORTALS             ( 8192 )
+
 struct reg_mobj_t
 {
     reg_mobj_t *next;  ///< In the register hash.
@@ -80,6 +94,8 @@ struct cregister_t
 void Sv_RegisterWorld(cregister_t *reg, dd_bool isInitial);
 void Sv_NewDelta(void *deltaPtr, deltatype_t type, duint id);
 dd_bool Sv_IsVoidDelta(void const *delta);
+dd_bool Sv_IsNullMobjDelta(void const *delta);
+void Sv_UpdatePvs(pool_t *pool);
 void Sv_PoolQueueClear(pool_t *pool);
 void Sv_GenerateNewDeltas(cregister_t *reg, dint clientNumber, dd_bool doUpdate);
 
@@ -89,6 +105,8 @@ cregister_t worldRegister;
 // The initial register is used when generating deltas for a new client.
 cregister_t initialRegister;
 
+byte netInterest = true;
+
 static dfloat deltaBaseScores[NUM_DELTA_TYPES];
 
 // Keep this zeroed out. Used if the register doesn't have data for
@@ -100,6 +118,168 @@ static inline ClientServerWorld &worldSys()
     return App_World();
 }
 
+/**
+ * Journal of the sectors and sides that have changed since the world register was
+ * last compared. Only the journaled elements need to be compared when generating the
+ * deltas of a frame, so the cost scales with the amount of change rather than with
+ * the size of the map.
+ */
+class ChangeJournal
+    : DENG2_OBSERVES(Sector,  LightLevelChange)
+    , DENG2_OBSERVES(Sector,  LightColorChange)
+    , DENG2_OBSERVES(Plane,   HeightChange)
+    , DENG2_OBSERVES(Surface, MaterialChange)
+    , DENG2_OBSERVES(Surface, ColorChange)
+    , DENG2_OBSERVES(Surface, OpacityChange)
+    , DENG2_OBSERVES(Line,    FlagsChange)
+{
+public:
+    ChangeJournal(world::Map &map)
+        : _sectorMarked(map.sectorCount(), false)
+        , _sideMarked  (map.sideCount(),   false)
+        , _sectorPlaneMoved(map.sectorCount(), 0)
+    {
+        map.forAllSectors([this] (Sector &sector)
+        {
+            sector.audienceForLightLevelChange() += this;
+            sector.audienceForLightColorChange() += this;
+            sector.forAllPlanes([this] (Plane &plane)
+            {
+                plane.audienceForHeightChange() += this;
+                observe(plane.surface());
+                return LoopContinue;
+            });
+            return LoopContinue;
+        });
+        map.forAllLines([this] (Line &line)
+        {
+            line.audienceForFlagsChange += this;
+            for (dint i = 0; i < 2; ++i)
+            {
+                line.side(i).forAllSurfaces([this] (Surface &surface)
+                {
+                    observe(surface);
+                    return LoopContinue;
+                });
+            }
+            return LoopContinue;
+        });
+    }
+
+    void markSector(dint index)
+    {
+        if (index < 0 || index >= _sectorMarked.size() || _sectorMarked[index]) return;
+        _sectorMarked[index] = true;
+        _sectors.append(index);
+    }
+
+    void markSide(dint index)
+    {
+        if (index < 0 || index >= _sideMarked.size() || _sideMarked[index]) return;
+        _sideMarked[index] = true;
+        _sides.append(index);
+    }
+
+    bool isSectorMarked(dint index) const { return _sectorMarked.at(index); }
+    bool isSideMarked  (dint index) const { return _sideMarked.at(index); }
+
+    /**
+     * Returns the changed sectors and clears the journal of them.
+     */
+    QVector<dint> takeSectors()
+    {
+        for (dint index : _sectors) _sectorMarked[index] = false;
+        QVector<dint> taken;
+        taken.swap(_sectors);
+        return taken;
+    }
+
+    /**
+     * Returns the changed sides and clears the journal of them.
+     */
+    QVector<dint> takeSides()
+    {
+        for (dint index : _sides) _sideMarked[index] = false;
+        QVector<dint> taken;
+        taken.swap(_sides);
+        return taken;
+    }
+
+    // Observers:
+    void sectorLightLevelChanged(Sector &sector) override
+    {
+        markSector(sector.indexInMap());
+    }
+
+    void sectorLightColorChanged(Sector &sector) override
+    {
+        markSector(sector.indexInMap());
+    }
+
+    /**
+     * Returns the number of plane movements so far. Used as a serial number for
+     * determining which planes have moved since a point in time.
+     */
+    duint32 planeMoveCount() const { return _planeMoves; }
+
+    /**
+     * Returns the value of planeMoveCount() when a plane of the sector last moved.
+     */
+    duint32 sectorPlaneMovedAt(dint index) const { return _sectorPlaneMoved.at(index); }
+
+    void planeHeightChanged(Plane &plane) override
+    {
+        dint const index = plane.sector().indexInMap();
+        _sectorPlaneMoved[index] = ++_planeMoves;
+        markSector(index);
+    }
+
+    void surfaceMaterialChanged(Surface &surface) override { markOwner(surface); }
+    void surfaceColorChanged   (Surface &surface) override { markOwner(surface); }
+    void surfaceOpacityChanged (Surface &surface) override { markOwner(surface); }
+
+    void lineFlagsChanged(Line &line, dint) override
+    {
+        markSide(line.front().indexInMap());
+        markSide(line.back ().indexInMap());
+    }
+
+private:
+    void observe(Surface &surface)
+    {
+        surface.audienceForMaterialChange() += this;
+        surface.audienceForColorChange()    += this;
+        surface.audienceForOpacityChange()  += this;
+    }
+
+    void markOwner(Surface &surface)
+    {
+        if (!surface.hasParent()) return;
+
+        world::MapElement &owner = surface.parent();
+        if (owner.type() == DMU_PLANE)
+        {
+            markSector(owner.as<Plane>().sector().indexInMap());
+        }
+        else if (owner.type() == DMU_SIDE)
+        {
+            markSide(owner.indexInMap());
+        }
+    }
+
+    QVector<bool> _sectorMarked;
+    QVector<bool> _sideMarked;
+    QVector<dint> _sectors;
+    QVector<dint> _sides;
+    QVector<duint32> _sectorPlaneMoved;
+    duint32 _planeMoves = 0;
+};
+
+static std::unique_ptr<ChangeJournal> changeJournal;
+
+// Compare all elements, too, and report changes missing from the journal.
+static bool checkChangeJournal;
+
 /**
  * Called once for each map, from R_SetupMap(). Initialize the world
  * register and drain all pools.
@@ -146,6 +326,9 @@ void Sv_InitPools()
         pool.queueSize     = 0;
         pool.allocatedSize = 0;
         pool.queue         = nullptr;
+        pool.pvs           = nullptr;  // PU_MAP memory.
+        pool.pvsSector     = -1;
+        pool.pvsPlaneMoves = 0;
 
         pool.isFirst       = true;  // Set to @c false when a frame is sent.
     }
@@ -154,6 +337,10 @@ void Sv_InitPools()
     Sv_RegisterWorld(&::worldRegister, false);
     Sv_RegisterWorld(&::initialRegister, true);
 
+    // Start journaling changes for the world register.
+    changeJournal.reset(new ChangeJournal(worldSys().map()));
+    checkChangeJournal = CommandLine_Exists("-checkjournal");
+
     // How much time did we spend?
     LOG_MAP_VERBOSE("World registered in %.2f seconds") << startedAt.since();
 }
@@ -163,7 +350,7 @@ void Sv_InitPools()
  */
 void Sv_ShutdownPools()
 {
-    // Nothing to do.
+    changeJournal.reset();
 }
 
 /**
@@ -1006,6 +1193,273 @@ void Sv_UpdateOwnerInfo(pool_t *pool)
     // client. If an unacked delta is not acked within the threshold, it'll be
     // re-included in the ratings.
     info->ackThreshold = 0; //Net_GetAckThreshold(pool->owner);
+
+    Sv_UpdatePvs(pool);
+}
+
+static inline void Sv_MarkPvs(pool_t *pool, dint sectorIndex)
+{
+    pool->pvs[sectorIndex >> 3] |= 1 << (sectorIndex & 7);
+}
+
+static inline bool Sv_InPvs(pool_t const *pool, dint sectorIndex)
+{
+    return (pool->pvs[sectorIndex >> 3] & (1 << (sectorIndex & 7))) != 0;
+}
+
+namespace {
+
+/**
+ * Determines the sectors that can be seen from a point, by passing through the
+ * openings of two-sided lines (portals). The range of directions in which the
+ * current sector can be seen (the window) narrows down at each portal, so only the
+ * sectors actually in sight are reached. The view direction does not matter, as
+ * the viewer may turn at any time. Heights are only used to determine whether the
+ * portals are open.
+ */
+struct PvsBuilder
+{
+    /// Range of directions, counterclockwise from @a start (radians).
+    struct Window
+    {
+        ddouble start;
+        ddouble width;
+    };
+
+    pool_t *pool;
+    Vector2d eye;
+    dint portalBudget = PVS_MAX_PORTALS;
+    QVector<bool> onPath; ///< Sectors on the current path (not entered again).
+
+    static ddouble normalized(ddouble angle)
+    {
+        angle = std::fmod(angle, 2 * de::PI);
+        return angle < 0? angle + 2 * de::PI : angle;
+    }
+
+    /**
+     * Intersects two windows. @a a may cover all directions.
+     *
+     * @return @c true, if the intersection is not empty.
+     */
+    static bool clip(Window const &a, Window const &b, Window &clipped)
+    {
+        if (a.width >= 2 * de::PI)
+        {
+            clipped = b;
+            return true;
+        }
+        ddouble const offset = normalized(b.start - a.start);
+        if (offset < a.width)
+        {
+            // Starts inside @a a.
+            clipped.start = b.start;
+            clipped.width = de::min(b.width, a.width - offset);
+            return true;
+        }
+        ddouble const reach = offset + b.width - 2 * de::PI;
+        if (reach > 0)
+        {
+            // Starts before @a a and reaches into it.
+            clipped.start = a.start;
+            clipped.width = de::min(reach, a.width);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Visits the sectors seen from @a sector through @a window.
+     *
+     * @return @c false, if the portal budget was exhausted.
+     */
+    bool visit(Sector const &sector, Window const &window)
+    {
+        onPath[sector.indexInMap()] = true;
+        LoopResult const result = sector.forAllSides([this, &sector, &window] (LineSide &side)
+        {
+            LineSide const &backSide = side.back();
+            if (!backSide.hasSector()) return LoopContinue;
+
+            Sector const &back = backSide.sector();
+            if (onPath.at(back.indexInMap())) return LoopContinue;
+
+            if (--portalBudget < 0) return LoopAbort;
+
+            // The sector is on the right side of the (side-relative) line.
+            Vector2d const from = side.from().origin() - eye;
+            Vector2d const to   = side.to  ().origin() - eye;
+            Vector2d const dir  = to - from;
+            ddouble const len   = dir.length();
+            if (len <= 0) return LoopContinue;
+            ddouble const eyeDist = dir.cross(-from) / len; // Negative: on the right.
+
+            Window through;
+            if (eyeDist > -1)
+            {
+                // The portal faces away from the eye, or the eye is practically on it.
+                if (eyeDist >= 1) return LoopContinue;
+                through = window;
+            }
+            else
+            {
+                ddouble const fromAngle = std::atan2(from.y, from.x);
+                ddouble const toAngle   = std::atan2(to.y,   to.x);
+                Window const portal { normalized(toAngle), normalized(fromAngle - toAngle) };
+                if (!clip(window, portal, through)) return LoopContinue;
+            }
+
+            // The back sector's walls and planes can be seen through the portal, even
+            // if it is closed.
+            Sv_MarkPvs(pool, back.indexInMap());
+
+            // Can we see further through the opening?
+            ddouble const openBottom = de::max(sector.floor().height(), back.floor().height());
+            ddouble const openTop    = de::min(sector.ceiling().height(), back.ceiling().height());
+            if (openTop > openBottom)
+            {
+                if (!visit(back, through)) return LoopAbort;
+            }
+            return LoopContinue;
+        });
+        onPath[sector.indexInMap()] = false;
+        return !result;
+    }
+};
+
+} // namespace
+
+/**
+ * Builds the potentially visible set of sectors for a viewer at @a eye in
+ * @a viewSector.
+ */
+void Sv_BuildPvs(pool_t *pool, Sector const &viewSector, Vector2d const &eye)
+{
+    world::Map const &map = worldSys().map();
+    size_t const pvsSize  = (map.sectorCount() + 7) / 8;
+
+    if (!pool->pvs)
+    {
+        pool->pvs = (byte *) Z_Malloc(pvsSize, PU_MAP, 0);
+    }
+    std::memset(pool->pvs, 0, pvsSize);
+    Sv_MarkPvs(pool, viewSector.indexInMap());
+
+    PvsBuilder builder;
+    builder.pool = pool;
+    builder.eye  = eye;
+    builder.onPath.fill(false, map.sectorCount());
+    if (!builder.visit(viewSector, PvsBuilder::Window{ 0, 2 * de::PI }))
+    {
+        // Too complicated; consider everything visible.
+        std::memset(pool->pvs, 0xff, pvsSize);
+    }
+
+    pool->pvsSector     = viewSector.indexInMap();
+    pool->pvsOrigin[VX] = eye.x;
+    pool->pvsOrigin[VY] = eye.y;
+    pool->pvsPlaneMoves = (changeJournal? changeJournal->planeMoveCount() : 0);
+}
+
+/**
+ * Determines whether a plane of a sector in the owner's potentially visible set has
+ * moved since the set was built. Portals on the boundary of the set may have opened
+ * or closed.
+ */
+static bool Sv_PvsPlanesMoved(pool_t *pool)
+{
+    if (!changeJournal) return true;
+
+    duint32 const moves = changeJournal->planeMoveCount();
+    if (moves == pool->pvsPlaneMoves) return false;
+
+    for (dint i = 0; i < worldSys().map().sectorCount(); ++i)
+    {
+        if (Sv_InPvs(pool, i) && changeJournal->sectorPlaneMovedAt(i) > pool->pvsPlaneMoves)
+        {
+            return true;
+        }
+    }
+
+    // None of the moved planes affect the set.
+    pool->pvsPlaneMoves = moves;
+    return false;
+}
+
+/**
+ * Rebuilds the owner's potentially visible set if the viewer has moved, or a plane
+ * on the boundary of the set has moved.
+ */
+void Sv_UpdatePvs(pool_t *pool)
+{
+    DENG2_ASSERT(pool);
+    mobj_t const *viewer = DD_Player(pool->owner)->publicData().mo;
+
+    if (!netInterest || !viewer || !worldSys().hasMap())
+    {
+        // Everything is visible.
+        pool->pvsSector = -1;
+        return;
+    }
+
+    Sector const *viewSector = Mobj_BspLeafAtOrigin(*viewer).sectorPtr();
+    if (!viewSector)
+    {
+        pool->pvsSector = -1;
+        return;
+    }
+
+    Vector2d const eye(viewer->origin);
+    if (pool->pvsSector != viewSector->indexInMap() ||
+        eye != Vector2d(pool->pvsOrigin) || Sv_PvsPlanesMoved(pool))
+    {
+        Sv_BuildPvs(pool, *viewSector, eye);
+    }
+}
+
+/**
+ * Determines whether the entity of a delta may be visible to the owner of the pool.
+ * Invisible deltas remain in the pool (merging with newer changes) until they become
+ * visible, so the client will catch up with their state.
+ */
+dd_bool Sv_IsVisibleDelta(void const *deltaPtr, pool_t const *pool)
+{
+    delta_t const *delta = (delta_t const *) deltaPtr;
+
+    if (!pool->pvs || pool->pvsSector < 0)
+    {
+        // No visibility information available.
+        return true;
+    }
+
+    Sector const *sector = nullptr;
+    switch (delta->type)
+    {
+    case DT_MOBJ:
+        // Removals are always sent so that the client forgets the mobj.
+        if (Sv_IsNullMobjDelta(delta)) return true;
+        sector = worldSys().map().bspLeafAt(Vector2d(((mobjdelta_t const *) delta)->mo.origin))
+                     .sectorPtr();
+        break;
+
+    case DT_SECTOR:
+        sector = worldSys().map().sectorPtr(delta->id);
+        break;
+
+    case DT_SIDE:
+        if (LineSide const *side = worldSys().map().sidePtr(delta->id))
+        {
+            sector = side->sectorPtr();
+        }
+        break;
+
+    default:
+        // Players, polyobjs and sounds are always of interest (sounds are limited
+        // by their audible distance instead).
+        return true;
+    }
+
+    return !sector || Sv_InPvs(pool, sector->indexInMap());
 }
 
 /**
@@ -2209,11 +2663,42 @@ void Sv_NewSectorDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
 {
     sectordelta_t delta;
 
-    for (int i = 0; i < worldSys().map().sectorCount(); ++i)
+    if (reg->isInitial || !changeJournal)
+    {
+        for (int i = 0; i < worldSys().map().sectorCount(); ++i)
+        {
+            if (Sv_RegisterCompareSector(reg, i, &delta, doUpdate))
+            {
+                Sv_AddDeltaToPools(&delta, targets);
+            }
+        }
+        return;
+    }
+
+    // Only the journaled sectors may have changed.
+    for (dint i : changeJournal->takeSectors())
     {
         if (Sv_RegisterCompareSector(reg, i, &delta, doUpdate))
         {
             Sv_AddDeltaToPools(&delta, targets);
+
+            // Keep comparing while the sector keeps changing (e.g., plane
+            // speed and target may change a frame after the height).
+            changeJournal->markSector(i);
+        }
+    }
+
+    if (checkChangeJournal)
+    {
+        for (int i = 0; i < worldSys().map().sectorCount(); ++i)
+        {
+            if (changeJournal->isSectorMarked(i)) continue;
+            if (Sv_RegisterCompareSector(reg, i, &delta, doUpdate))
+            {
+                LOGDEV_NET_WARNING("Sector %i changed without a journal entry (flags:%x)")
+                        << i << delta.delta.flags;
+                Sv_AddDeltaToPools(&delta, targets);
+            }
         }
     }
 }
@@ -2225,34 +2710,53 @@ void Sv_NewSectorDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
  */
 void Sv_NewSideDeltas(cregister_t *reg, dd_bool doUpdate, pool_t **targets)
 {
-    static uint numShifts = 2, shift = 0;
+    static uint shift = 0;
 
     /// @todo fixme: Do not assume the current map.
     world::Map &map = worldSys().map();
 
+    sidedelta_t delta;
+
     // When comparing against an initial register, always compare all
     // sides (since the comparing is only done once, not continuously).
-    uint start, end;
-    if (reg->isInitial)
+    if (reg->isInitial || !changeJournal)
     {
-        start = 0;
-        end = map.sideCount();
+        for (dint i = 0; i < map.sideCount(); ++i)
+        {
+            if (Sv_RegisterCompareSide(reg, i, &delta, doUpdate))
+            {
+                Sv_AddDeltaToPools(&delta, targets);
+            }
+        }
+        return;
     }
-    else
+
+    // Materials, colors and line flags are journaled.
+    QVector<dint> const changed = changeJournal->takeSides();
+    for (dint i : changed)
     {
-        // Because there are so many sides in a typical map, the number
-        // of compared sides soon accumulates to millions. To reduce the
-        // load, we'll check only a portion of all sides for a frame.
-        start = shift * map.sideCount() / numShifts;
-        end = ++shift * map.sideCount() / numShifts;
-        shift %= numShifts;
+        if (Sv_RegisterCompareSide(reg, i, &delta, doUpdate))
+        {
+            Sv_AddDeltaToPools(&delta, targets);
+        }
     }
 
-    sidedelta_t delta;
+    // Blend modes and side flags are not journaled. They change so rarely that
+    // it is enough to sweep through a small portion of the sides every frame.
+    uint const start = shift * map.sideCount() / SIDE_SWEEP_FRAMES;
+    uint const end   = ++shift * map.sideCount() / SIDE_SWEEP_FRAMES;
+    shift %= SIDE_SWEEP_FRAMES;
+
     for (uint i = start; i < end; ++i)
     {
         if (Sv_RegisterCompareSide(reg, i, &delta, doUpdate))
         {
+            if (checkChangeJournal && !changed.contains(dint(i)) &&
+                (delta.delta.flags & ~(SIDF_MID_BLENDMODE | SIDF_FLAGS)))
+            {
+                LOGDEV_NET_WARNING("Side %i changed without a journal entry (flags:%x)")
+                        << i << delta.delta.flags;
+            }
             Sv_AddDeltaToPools(&delta, targets);
         }
     }
@@ -2659,6 +3163,12 @@ dd_bool Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
         return false;
     }
 
+    if (!Sv_IsVisibleDelta(delta, info->pool))
+    {
+        // Deferred until the client can see it.
+        return false;
+    }
+
     // Calculate the distance to the delta's origin.
     // If no distance can be determined, it's 1.0.
     distance = Sv_DeltaDistance(delta, info);
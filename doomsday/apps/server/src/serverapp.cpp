@@ -252,6 +252,10 @@ void ServerApp::initialize()
         LogBuffer::get().enableStandardOutput(false);
     }
 
+    // Format and write log entries in the background so that logging does not
+    // stall the game loop.
+    LogBuffer::get().enableAsyncFlushing();
+
     Def_Init();
 
     // Load the server's packages.
@@ -37,6 +37,7 @@
 
 #include "server/sv_def.h"
 #include "server/sv_frame.h"
+#include "server/sv_pool.h"
 
 #include "network/net_main.h"
 #include "network/net_buf.h"
@@ -46,6 +47,7 @@
 
 #include "dd_main.h"
 #include "dd_loop.h"
+#include "misc/tictimings.h"
 #include "sys_system.h"
 #include "world/map.h"
 #include "world/p_players.h"
@@ -312,8 +314,9 @@ void ServerSystem::timeChanged(Clock const &clock)
 
     Garbage_Recycle();
 
-    // Adjust loop rate depending on whether users are connected.
-    DENG2_TEXT_APP->loop().setRate(userCount()? 35 : 3);
+    // Adjust loop rate depending on whether users are connected. Tic timings are
+    // measured as fast as possible.
+    DENG2_TEXT_APP->loop().setRate(TicTimings_IsActive()? 0 : userCount()? 35 : 3);
 
     Loop_RunTics();
 
@@ -324,7 +327,9 @@ void ServerSystem::timeChanged(Clock const &clock)
 
     /// @todo There's no need to queue packets via net_buf, just handle
     /// them right away.
+    timespan_t const startedAt = Timer_Seconds();
     Sv_GetPackets();
+    TicTimings_Add(TICTIME_MESSAGES, Timer_Seconds() - startedAt);
 
     /// @todo Kick unjoined nodes who are silent for too long.
 }
@@ -377,6 +382,7 @@ void Server_Register()
 {
     C_VAR_CHARPTR("net-ip-address", &nptIPAddress, 0, 0, 0);
     C_VAR_INT    ("net-ip-port",    &nptIPPort, CVF_NO_MAX, 0, 0);
+    C_VAR_BYTE   ("net-interest",   &netInterest, 0, 0, 1);
 
 #ifdef _DEBUG
     C_CMD("netfreq", NULL, NetFreqs);
@@ -35,6 +35,11 @@ class Task;
  * TaskPool instance for each group of concurrent tasks whose state needs to be
  * observed as a whole.
  *
+ * The background threads are scheduled using work stealing. Tasks started from
+ * within a running task are queued locally in the same thread, and idle threads
+ * steal work from busy ones. When a task waits for another pool to finish, the
+ * thread keeps running other pending tasks instead of blocking.
+ *
  * While TaskPool allows the user to monitor whether all tasks are done and
  * block until that time arrives (TaskPool::waitForDone()), no facilities are
  * provided for interrupting any of the started tasks. If that is required, the
@@ -62,6 +67,17 @@ public:
     };
 
     typedef std::function<void ()> TaskFunction;
+    typedef std::function<void (int begin, int end)> RangeFunction;
+
+    /// Instrumentation of the shared background threads.
+    struct Statistics
+    {
+        int threadCount    = 0;
+        int queuedTasks    = 0; ///< Tasks currently waiting to be run.
+        int maxQueuedTasks = 0; ///< Highest number of waiting tasks seen.
+        duint executedTasks = 0;
+        duint stolenTasks   = 0; ///< Tasks taken from another thread's queue.
+    };
 
     DENG2_DEFINE_AUDIENCE2(Done, void taskPoolDone(TaskPool &))
 
@@ -86,9 +102,23 @@ public:
 
     void start(TaskFunction taskFunction, Priority priority = LowPriority);
 
+    /**
+     * Sets a function to be started as a new task once all the tasks of the pool
+     * have finished. If the pool is already done, the function is started
+     * immediately. Continuations can be used to make a group of tasks depend on
+     * the completion of another group.
+     *
+     * @param continuation  Function to start.
+     * @param priority      Priority of the continuation task.
+     */
+    void whenDone(TaskFunction continuation, Priority priority = LowPriority);
+
     /**
      * Blocks execution until all running tasks have finished. A Task is considered
      * finished when it has exited its Task::runTask() method.
+     *
+     * If called from within a task, the thread runs other pending tasks while
+     * waiting.
      */
     void waitForDone();
 
@@ -97,6 +127,22 @@ public:
      */
     bool isDone() const;
 
+    /**
+     * Calls a function concurrently for subranges of [0, count), and returns when
+     * all of the subranges have been processed. The calling thread also takes part
+     * in the work.
+     *
+     * @param count      Number of items.
+     * @param func       Function to call for each subrange [begin, end).
+     * @param grainSize  Minimum number of items per subrange. If zero, the range is
+     *                   split evenly for the available threads.
+     * @param priority   Priority of the tasks.
+     */
+    static void parallelFor(int count, RangeFunction func, int grainSize = 0,
+                            Priority priority = HighPriority);
+
+    static Statistics statistics();
+
 signals:
     void allTasksDone();
 
@@ -772,6 +772,7 @@ class DENG2_PUBLIC LogEntryStager
 {
 public:
     LogEntryStager(duint32 metadata, String const &format);
+    LogEntryStager(duint32 metadata, char const *format);
 
     /// Appends a new argument to the entry.
     template <typename ValueType>
@@ -785,6 +786,9 @@ public:
 
     ~LogEntryStager();
 
+private:
+    bool begin();
+
 private:
     bool _disabled;
     duint32 _metadata;
@@ -157,6 +157,19 @@ public:
      */
     void setAutoFlushInterval(TimeSpan const &interval);
 
+    /**
+     * Enables or disables flushing in a background thread. When enabled, adding
+     * an entry never formats or writes anything in the calling thread; the
+     * entries are written to the sinks by a dedicated thread instead. All sinks
+     * must then be prepared to be flushed from a thread other than the main
+     * thread.
+     *
+     * @param yes  @c true or @c false.
+     */
+    void enableAsyncFlushing(bool yes = true);
+
+    bool isAsyncFlushingEnabled() const;
+
     enum OutputChangeBehavior {
         FlushFirstToOldOutputs,
         DontFlush
@@ -0,0 +1,132 @@
+/** @file blockstore.h  Persistent single-file key/value store.
+ *
+ * @authors Copyright © 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDENG2_BLOCKSTORE_H
+#define LIBDENG2_BLOCKSTORE_H
+
+#include "../Block"
+#include "../NativePath"
+
+#include <QList>
+
+namespace de {
+
+/**
+ * Persistent key/value store where all the entries are kept in a single native file.
+ *
+ * The file is a log: setting or removing an entry always appends a new record to the
+ * end of the file, and each record is checksummed. If the application is terminated
+ * in the middle of an append, the incomplete record is discarded the next time the
+ * store is opened. Records that have been superseded by later ones become garbage,
+ * which is reclaimed by compacting the file in a background thread once there is
+ * enough of it.
+ *
+ * The locations of the entries are kept in an index file next to the data file
+ * ("<name>.index"). It is rewritten when the store is compacted or closed. When
+ * opening the store, the index is read from a memory-mapped file, after which only
+ * the records appended since the index was written need to be checked. The data file
+ * is also memory-mapped for reading values.
+ *
+ * Looking up an entry takes constant time. BlockStore is thread-safe.
+ *
+ * @ingroup data
+ */
+class DENG2_PUBLIC BlockStore
+{
+public:
+    /// The store file could not be opened or created. @ingroup errors
+    DENG2_ERROR(OpenError);
+
+    /// Writing to the store file failed. @ingroup errors
+    DENG2_ERROR(WriteError);
+
+    struct Statistics
+    {
+        int entryCount = 0;
+        dsize fileSize = 0;     ///< Total size of the data file.
+        dsize garbageSize = 0;  ///< Bytes occupied by superseded records.
+        int compactionCount = 0;
+    };
+
+public:
+    /**
+     * Opens a store, creating the file if it doesn't exist yet.
+     *
+     * @param filePath  Native path of the data file.
+     */
+    BlockStore(NativePath const &filePath);
+
+    /**
+     * Waits for an ongoing compaction to finish and writes the index.
+     */
+    ~BlockStore();
+
+    NativePath filePath() const;
+
+    bool contains(Block const &key) const;
+
+    /**
+     * Returns the value of an entry.
+     *
+     * @param key  Key of the entry.
+     *
+     * @return Value, or an empty Block if there is no such entry.
+     */
+    Block value(Block const &key) const;
+
+    /**
+     * Returns the size of an entry's value in bytes, or zero if there is no such entry.
+     */
+    dsize valueSize(Block const &key) const;
+
+    /**
+     * Returns the keys of all the entries, in no particular order.
+     */
+    QList<Block> keys() const;
+
+    void set(Block const &key, Block const &value);
+
+    void remove(Block const &key);
+
+    /**
+     * Removes all entries. The data file is truncated.
+     */
+    void clear();
+
+    /**
+     * Writes the index file so that the current entries can be found quickly the
+     * next time the store is opened.
+     */
+    void flush();
+
+    /**
+     * Rewrites the data file so that it only contains the current entries. This is
+     * done automatically in the background when there is enough garbage in the file.
+     * Blocks until the compaction is complete.
+     */
+    void compact();
+
+    Statistics statistics() const;
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+} // namespace de
+
+#endif // LIBDENG2_BLOCKSTORE_H
@@ -43,7 +43,7 @@ public:
     /**
      * Adds a new metadata entry into the bank.
      *
-     * @param category  Metadata category. Each category is saved in its own subfolder.
+     * @param category  Metadata category.
      * @param id        Meta ID.
      *
      * @return The cached metadata, if available. This will be an empty Block if no
@@ -85,6 +85,13 @@ public:
      */
     virtual LoopResult forPackageIds(std::function<LoopResult (String const &packageId)> func) const = 0;
 
+    /**
+     * Determines if the repository can provide file manifests and ranges of file
+     * contents (see RemoteFeedQueryPacket::FileManifest). Otherwise, files can only be
+     * transferred in their entirety.
+     */
+    virtual bool supportsChunkedTransfers() const;
+
     QueryId sendQuery(Query query);
 
     virtual File *populateRemotePath(String const &packageId, RepositoryPath const &path) const;
@@ -106,6 +113,9 @@ protected:
 
     void chunkReceived(QueryId id, duint64 startOffset, Block const &chunk, duint64 fileSize);
 
+    void manifestReceived(QueryId id, duint64 fileSize, dsize chunkSize,
+                          QList<Block> const &chunkHashes);
+
     virtual void wasConnected();
 
     virtual void wasDisconnected();
@@ -40,6 +40,8 @@ public:
 
     LoopResult forPackageIds(std::function<LoopResult (String const &packageId)> func) const override;
 
+    bool supportsChunkedTransfers() const override;
+
 protected:
     NativeLink(String const &address);
 
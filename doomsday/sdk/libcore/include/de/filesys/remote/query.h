@@ -49,6 +49,7 @@ typedef QHash<String, RepositoryPath> PackagePaths;
 
 typedef std::function<void (DictionaryValue const &)> FileMetadata;
 typedef std::function<void (duint64 startOffset, Block const &, duint64 remainingBytes)> FileContents;
+typedef std::function<void (duint64 fileSize, dsize chunkSize, QList<Block> const &chunkHashes)> FileManifest;
 
 template <typename Callback>
 using Request = std::shared_ptr<AsyncCallback<Callback>>;
@@ -63,10 +64,14 @@ struct DENG2_PUBLIC Query
     QueryId id;
     String path;
     StringList packageIds;
+    duint64 rangeOffset = 0;
+    duint64 rangeSize = 0;      ///< Zero means the entire file.
+    dsize chunkSize = 0;        ///< Chunk size for the manifest.
 
     // Callbacks:
     Request<FileMetadata> fileMetadata;
     Request<FileContents> fileContents;
+    Request<FileManifest> fileManifest;
 
     // Internal status:
     duint64 receivedBytes = 0;
@@ -75,6 +80,8 @@ struct DENG2_PUBLIC Query
 public:
     Query(Request<FileMetadata> req, String path);
     Query(Request<FileContents> req, String path);
+    Query(Request<FileContents> req, String path, duint64 rangeOffset, duint64 rangeSize);
+    Query(Request<FileManifest> req, String path, dsize chunkSize);
     bool isValid() const;
     void cancel();
 };
@@ -32,16 +32,26 @@ namespace de {
 class DENG2_PUBLIC RemoteFeedQueryPacket : public IdentifiedPacket
 {
 public:
-    enum Query { ListFiles, FileContents };
+    enum Query {
+        ListFiles,
+        FileContents,
+        FileManifest,   ///< Hashes of the file's chunks.
+        FileRange       ///< Contents of part of the file.
+    };
 
 public:
     RemoteFeedQueryPacket();
 
     void setQuery(Query query);
     void setPath(String const &path);
+    void setRange(duint64 offset, duint64 size);
+    void setChunkSize(dsize chunkSize);
 
     Query query() const;
     String path() const;
+    duint64 rangeOffset() const;
+    duint64 rangeSize() const;
+    dsize chunkSize() const;
 
     // Implements ISerializable.
     void operator >> (Writer &to) const;
@@ -52,6 +62,9 @@ public:
 private:
     Query _query;
     String _path;
+    duint64 _rangeOffset = 0;
+    duint64 _rangeSize = 0;
+    dsize _chunkSize = 0;
 };
 
 /**
@@ -109,6 +122,41 @@ private:
     Block _data;
 };
 
+/**
+ * Packet that lists the hashes of a file's chunks. Used as a response to the
+ * FileManifest query. Chunks with identical hashes only need to be transferred
+ * once. @ingroup fs
+ */
+class DENG2_PUBLIC RemoteFeedManifestPacket : public IdentifiedPacket
+{
+public:
+    RemoteFeedManifestPacket();
+
+    void setFileSize(duint64 size);
+    void setChunkSize(dsize chunkSize);
+    void setChunkHashes(QList<Block> const &hashes);
+
+    duint64 fileSize() const;
+    dsize chunkSize() const;
+    QList<Block> const &chunkHashes() const;
+
+    // Implements ISerializable.
+    void operator >> (Writer &to) const;
+    void operator << (Reader &from);
+
+    static Packet *fromBlock(Block const &block);
+
+    /**
+     * Calculates the hash of a chunk of data.
+     */
+    static Block chunkHash(IByteArray const &chunk);
+
+private:
+    duint64 _fileSize = 0;
+    dsize _chunkSize = 0;
+    QList<Block> _hashes;
+};
+
 /**
  * Network message protocol for remote feeds.
  */
@@ -123,6 +171,7 @@ public:
         Query,          ///< Query for file metadata or contents.
         Metadata,       ///< Response containing metadata.
         FileContents,
+        Manifest,       ///< Response containing chunk hashes.
     };
 
 public:
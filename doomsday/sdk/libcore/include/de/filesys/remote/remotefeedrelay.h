@@ -81,10 +81,34 @@ public:
                                         String folderPath,
                                         FileMetadata metadataReceived);
 
+    /**
+     * Requests the contents of a file. If the repository supports it, the file is
+     * transferred in chunks, several of which can be requested at the same time.
+     * Received chunks are kept in a local cache, and only the chunks not found in
+     * the cache are requested. The chunks are not necessarily received in order.
+     *
+     * @param repository        Repository address.
+     * @param filePath          Path of the file in the repository.
+     * @param contentsReceived  Called first with the total size of the file, and then
+     *                          for each received part of the file.
+     */
     Request<FileContents> fetchFileContents(String const &repository,
                                             String filePath,
                                             FileContents contentsReceived);
 
+    /**
+     * Sets the parameters for chunked file transfers.
+     *
+     * @param chunkSize          Size of a chunk in bytes.
+     * @param maxChunksInFlight  Maximum number of chunks requested at the same time
+     *                           for a single file.
+     */
+    void setChunkedTransferParameters(dsize chunkSize, int maxChunksInFlight);
+
+    dsize chunkSize() const;
+
+    int maxChunksInFlight() const;
+
     QNetworkAccessManager &network();
 
 private:
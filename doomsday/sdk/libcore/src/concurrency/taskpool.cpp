@@ -19,8 +19,9 @@
 #include "de/TaskPool"
 #include "de/Task"
 #include "de/Guard"
+#include "de/math.h"
+#include "taskscheduler.h"
 
-#include <QThreadPool>
 #include <QSet>
 #include <de/Lockable>
 #include <de/Loop>
@@ -48,6 +49,13 @@ DENG2_PIMPL(TaskPool), public Lockable, public Waitable, public TaskPool::IPool
     /// Set of running tasks.
     QSet<Task *> tasks;
 
+    struct Continuation
+    {
+        TaskFunction func;
+        Priority priority;
+    };
+    QList<Continuation> continuations;
+
     Impl(Public *i) : Base(i)
     {
         // When empty, the semaphore is available.
@@ -93,17 +101,42 @@ DENG2_PIMPL(TaskPool), public Lockable, public Waitable, public TaskPool::IPool
         post(); // When empty, the semaphore is available.
     }
 
+    /**
+     * Waits until the pool is empty, or until @a timeOut has passed.
+     *
+     * @return @c true, if the pool is empty.
+     */
+    bool waitForEmpty(TimeSpan const &timeOut) const
+    {
+        if (!tryWait(timeOut)) return false;
+        post(); // When empty, the semaphore is available.
+        return true;
+    }
+
     bool isEmpty() const
     {
         DENG2_GUARD(this);
         return tasks.isEmpty();
     }
 
+    void startContinuations()
+    {
+        // The continuations are not part of this pool.
+        for (Continuation const &cont : continuations)
+        {
+            internal::TaskScheduler::get().start(new internal::CallbackTask(cont.func),
+                                                 cont.priority);
+        }
+        continuations.clear();
+    }
+
     void taskFinishedRunning(Task &task)
     {
         lock();
         if (remove(&task))
         {
+            startContinuations();
+
             if (deleteWhenDone)
             {
                 // All done, clean up!
@@ -152,7 +185,7 @@ TaskPool::~TaskPool()
 void TaskPool::start(Task *task, Priority priority)
 {
     d->add(task);
-    QThreadPool::globalInstance()->start(task, int(priority));
+    internal::TaskScheduler::get().start(task, priority);
 }
 
 void TaskPool::start(TaskFunction taskFunction, Priority priority)
@@ -160,8 +193,33 @@ void TaskPool::start(TaskFunction taskFunction, Priority priority)
     start(new internal::CallbackTask(taskFunction), priority);
 }
 
+void TaskPool::whenDone(TaskFunction continuation, Priority priority)
+{
+    DENG2_GUARD(d);
+    d->continuations.append(Impl::Continuation{ continuation, priority });
+    if (d->tasks.isEmpty())
+    {
+        d->startContinuations();
+    }
+}
+
 void TaskPool::waitForDone()
 {
+    auto &sched = internal::TaskScheduler::get();
+    if (sched.isWorkerThread())
+    {
+        // Blocking would take a thread away from the pool; help out instead.
+        while (!d->isEmpty())
+        {
+            if (!sched.runPendingTask())
+            {
+                // Nothing to steal at the moment. Sleep until the pool is done, but
+                // check again periodically for new tasks to help with.
+                d->waitForEmpty(0.001);
+            }
+        }
+        return;
+    }
     d->waitForEmpty();
 }
 
@@ -170,4 +228,27 @@ bool TaskPool::isDone() const
     return d->isEmpty();
 }
 
+void TaskPool::parallelFor(int count, RangeFunction func, int grainSize, Priority priority)
+{
+    if (count <= 0) return;
+
+    int const threads = statistics().threadCount + 1;
+    int const chunk = de::max(de::max(1, grainSize), (count + threads - 1) / threads);
+
+    // The first subrange is processed in the calling thread.
+    TaskPool pool;
+    for (int begin = chunk; begin < count; begin += chunk)
+    {
+        int const end = de::min(begin + chunk, count);
+        pool.start([&func, begin, end] () { func(begin, end); }, priority);
+    }
+    func(0, de::min(chunk, count));
+    pool.waitForDone();
+}
+
+TaskPool::Statistics TaskPool::statistics()
+{
+    return internal::TaskScheduler::get().statistics();
+}
+
 } // namespace de
@@ -0,0 +1,247 @@
+/** @file taskscheduler.cpp  Work-stealing scheduler for concurrent tasks.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "taskscheduler.h"
+#include "de/Task"
+#include "de/math.h"
+
+#include <QThread>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace de {
+namespace internal {
+
+static int const PRIORITY_COUNT = TaskPool::HighPriority + 1;
+
+DENG2_PIMPL_NOREF(TaskScheduler)
+{
+    struct Worker : public QThread
+    {
+        Impl &sched;
+        int index;
+        std::mutex mutex;
+        std::deque<Task *> tasks; ///< Owner uses the back, thieves the front.
+
+        Worker(Impl &sched, int index) : sched(sched), index(index) {}
+
+        void run() override
+        {
+            sched.workerLoop(*this);
+        }
+    };
+
+    std::vector<Worker *> workers;
+
+    std::mutex sharedMutex;
+    std::deque<Task *> shared[PRIORITY_COUNT];
+
+    std::mutex idleMutex;
+    std::condition_variable wakeUp;
+    std::atomic_int pending { 0 }; ///< Number of queued tasks.
+    bool stopping = false;
+
+    // Instrumentation.
+    std::atomic_uint executed { 0 };
+    std::atomic_uint stolen   { 0 };
+    std::atomic_int  maxQueued { 0 };
+
+    Impl()
+    {
+        int const count = de::max(1, QThread::idealThreadCount());
+        for (int i = 0; i < count; ++i)
+        {
+            workers.push_back(new Worker(*this, i));
+        }
+        for (Worker *w : workers)
+        {
+            w->start();
+        }
+    }
+
+    ~Impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (Worker *w : workers)
+        {
+            w->wait();
+            delete w;
+        }
+    }
+
+    Worker *currentWorker() const
+    {
+        Worker *w = dynamic_cast<Worker *>(QThread::currentThread());
+        return (w && &w->sched == this)? w : nullptr;
+    }
+
+    void start(Task *task, TaskPool::Priority priority)
+    {
+        if (Worker *w = currentWorker())
+        {
+            // Keep the work local to this thread: likely to be waited upon soon.
+            std::lock_guard<std::mutex> lock(w->mutex);
+            w->tasks.push_back(task);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(sharedMutex);
+            shared[de::clamp(0, int(priority), PRIORITY_COUNT - 1)].push_back(task);
+        }
+
+        int const queued = ++pending;
+        if (queued > maxQueued) maxQueued = queued;
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+        }
+        wakeUp.notify_one();
+    }
+
+    Task *takeOwn(Worker &w)
+    {
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (w.tasks.empty()) return nullptr;
+        Task *task = w.tasks.back();
+        w.tasks.pop_back();
+        return task;
+    }
+
+    Task *takeShared()
+    {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        for (int p = PRIORITY_COUNT - 1; p >= 0; --p)
+        {
+            if (!shared[p].empty())
+            {
+                Task *task = shared[p].front();
+                shared[p].pop_front();
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    Task *steal(Worker &thief)
+    {
+        for (dsize n = 1; n < workers.size(); ++n)
+        {
+            Worker &victim = *workers[(thief.index + n) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                Task *task = victim.tasks.front();
+                victim.tasks.pop_front();
+                stolen++;
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    Task *findTask(Worker &w)
+    {
+        if (!pending) return nullptr;
+
+        Task *task = takeOwn(w);
+        if (!task) task = takeShared();
+        if (!task) task = steal(w);
+        if (task) pending--;
+        return task;
+    }
+
+    void execute(Task *task)
+    {
+        bool const autoDelete = task->autoDelete();
+        task->run();
+        if (autoDelete) delete task;
+        executed++;
+    }
+
+    void workerLoop(Worker &w)
+    {
+        for (;;)
+        {
+            if (Task *task = findTask(w))
+            {
+                execute(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(idleMutex);
+            wakeUp.wait(lock, [this] () { return stopping || pending > 0; });
+            if (stopping) break;
+        }
+    }
+};
+
+TaskScheduler &TaskScheduler::get()
+{
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler() : d(new Impl)
+{}
+
+TaskScheduler::~TaskScheduler()
+{}
+
+void TaskScheduler::start(Task *task, TaskPool::Priority priority)
+{
+    d->start(task, priority);
+}
+
+bool TaskScheduler::runPendingTask()
+{
+    Impl::Worker *w = d->currentWorker();
+    DENG2_ASSERT(w != nullptr);
+    if (!w) return false;
+
+    if (Task *task = d->findTask(*w))
+    {
+        d->execute(task);
+        return true;
+    }
+    return false;
+}
+
+bool TaskScheduler::isWorkerThread() const
+{
+    return d->currentWorker() != nullptr;
+}
+
+TaskPool::Statistics TaskScheduler::statistics() const
+{
+    TaskPool::Statistics stats;
+    stats.threadCount    = int(d->workers.size());
+    stats.queuedTasks    = de::max(0, int(d->pending));
+    stats.maxQueuedTasks = d->maxQueued;
+    stats.executedTasks  = d->executed;
+    stats.stolenTasks    = d->stolen;
+    return stats;
+}
+
+} // namespace internal
+} // namespace de
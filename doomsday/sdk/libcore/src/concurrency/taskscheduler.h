@@ -0,0 +1,75 @@
+/** @file taskscheduler.h  Work-stealing scheduler for concurrent tasks.
+ *
+ * @authors Copyright (c) 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDENG2_TASKSCHEDULER_H
+#define LIBDENG2_TASKSCHEDULER_H
+
+#include "de/TaskPool"
+
+namespace de {
+namespace internal {
+
+/**
+ * Shared pool of worker threads that execute the tasks of all TaskPools.
+ *
+ * Each worker has its own deque of tasks. Tasks started by a worker thread are
+ * pushed to the worker's own deque, from which the worker takes the newest task
+ * first. Tasks started by other threads are placed in shared queues, one per
+ * priority. An idle worker first checks its own deque, then the shared queues in
+ * order of priority, and finally steals the oldest task of another worker.
+ *
+ * A worker that needs to wait for other tasks to finish can keep executing pending
+ * tasks in the meantime (see runPendingTask()).
+ */
+class TaskScheduler
+{
+public:
+    static TaskScheduler &get();
+
+    TaskScheduler();
+    ~TaskScheduler();
+
+    /**
+     * Queues a task for execution. The task is deleted after it has run if it is
+     * set to auto-delete.
+     */
+    void start(Task *task, TaskPool::Priority priority);
+
+    /**
+     * Executes one pending task in the calling thread, if there is one available.
+     * Only worker threads may call this.
+     *
+     * @return @c true, if a task was executed.
+     */
+    bool runPendingTask();
+
+    /**
+     * Determines if the calling thread is one of the scheduler's workers.
+     */
+    bool isWorkerThread() const;
+
+    TaskPool::Statistics statistics() const;
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+} // namespace internal
+} // namespace de
+
+#endif // LIBDENG2_TASKSCHEDULER_H
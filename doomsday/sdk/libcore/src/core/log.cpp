@@ -613,6 +613,11 @@ DENG2_PIMPL_NOREF(Log)
     duint32 currentEntryMedata; ///< Applies to the current entry being staged in the thread.
     int interactive = 0;
 
+    // The section context is composed only when the section stack has changed.
+    bool contextValid = false;
+    String context;
+    int contextDepth = 0;
+
     Impl()
         : throwawayEntry(new LogEntry) ///< A disabled LogEntry, so doesn't accept arguments.
         , currentEntryMedata(0)
@@ -624,6 +629,31 @@ DENG2_PIMPL_NOREF(Log)
     {
         delete throwawayEntry;
     }
+
+    void updateContext()
+    {
+        if (contextValid) return;
+
+        context.clear();
+        contextDepth = 0;
+        char const *latest = nullptr;
+        foreach (char const *i, sectionStack)
+        {
+            if (latest && !qstrcmp(i, latest))
+            {
+                // Don't repeat if it has the exact same name (due to recursive calls).
+                continue;
+            }
+            if (context.size())
+            {
+                context += " > ";
+            }
+            latest = i;
+            context += i;
+            ++contextDepth;
+        }
+        contextValid = true;
+    }
 };
 
 Log::Log() : d(new Impl)
@@ -650,12 +680,14 @@ bool Log::isStaging() const
 void Log::beginSection(char const *name)
 {
     d->sectionStack.push_back(name);
+    d->contextValid = false;
 }
 
 void Log::endSection(char const *DENG2_DEBUG_ONLY(name))
 {
     DENG2_ASSERT(d->sectionStack.back() == name);
     d->sectionStack.pop_back();
+    d->contextValid = false;
 }
 
 void Log::beginInteractive()
@@ -699,27 +731,10 @@ LogEntry &Log::enter(duint32 metadata, String const &format, LogEntry::Args argu
     }
 
     // Collect the sections.
-    String context;
-    String latest;
-    int depth = 0;
-    foreach (char const *i, d->sectionStack)
-    {
-        if (i == latest)
-        {
-            // Don't repeat if it has the exact same name (due to recursive calls).
-            continue;
-        }
-        if (context.size())
-        {
-            context += " > ";
-        }
-        latest = i;
-        context += i;
-        ++depth;
-    }
+    d->updateContext();
 
     // Make a new entry.
-    LogEntry *entry = new LogEntry(metadata, context, depth, format, arguments);
+    LogEntry *entry = new LogEntry(metadata, d->context, d->contextDepth, format, arguments);
 
     // Add it to the application's buffer. The buffer gets ownership.
     LogBuffer::get().add(entry);
@@ -782,35 +797,55 @@ void Log::disposeThreadLog()
 LogEntryStager::LogEntryStager(duint32 metadata, String const &format)
     : _metadata(metadata)
 {
-    if (!LogBuffer::appBufferExists())
+    if (begin())
     {
-        _disabled = true;
+        _format = format;
     }
-    else
+}
+
+LogEntryStager::LogEntryStager(duint32 metadata, char const *format)
+    : _metadata(metadata)
+{
+    // The format string is not converted at all if the entry is filtered out.
+    if (begin())
     {
-        auto &log = LOG();
+        _format = format;
+    }
+}
 
-        // Automatically set the Generic domain.
-        if (!(_metadata & LogEntry::DomainMask))
-        {
-            _metadata |= LogEntry::Generic;
-        }
+bool LogEntryStager::begin()
+{
+    _disabled = true;
 
-        // Flag interactive messages.
-        if (log.isInteractive())
-        {
-            _metadata |= LogEntry::Interactive;
-        }
+    if (!LogBuffer::appBufferExists()) return false;
 
-        _disabled = !LogBuffer::get().isEnabled(_metadata);
+    LogBuffer const &buf = LogBuffer::get();
 
-        if (!_disabled)
-        {
-            _format = format;
+    // Automatically set the Generic domain.
+    if (!(_metadata & LogEntry::DomainMask))
+    {
+        _metadata |= LogEntry::Generic;
+    }
 
-            log.setCurrentEntryMetadata(_metadata);
-        }
+    // Being interactive can only let more entries through, so filtered entries can
+    // be rejected before looking up the thread's log.
+    if (!buf.isEnabled(_metadata | LogEntry::Interactive)) return false;
+
+    auto &log = LOG();
+
+    // Flag interactive messages.
+    if (log.isInteractive())
+    {
+        _metadata |= LogEntry::Interactive;
+    }
+
+    _disabled = !buf.isEnabled(_metadata);
+
+    if (!_disabled)
+    {
+        log.setCurrentEntryMetadata(_metadata);
     }
+    return !_disabled;
 }
 
 LogEntryStager::~LogEntryStager()
@@ -30,11 +30,15 @@
 #include "de/Writer"
 
 #include <stdio.h>
+#include <atomic>
 #include <QTextStream>
 #include <QCoreApplication>
 #include <QList>
 #include <QSet>
+#include <QThread>
 #include <QTimer>
+#include <QMutex>
+#include <QWaitCondition>
 #include <QDebug>
 
 namespace de {
@@ -50,7 +54,7 @@ DENG2_PIMPL(LogBuffer)
     IFilter const *entryFilter;
     dint maxEntryCount;
     bool useStandardOutput;
-    bool flushingEnabled;
+    std::atomic_bool flushingEnabled;
     String outputPath;
     FileLogSink *fileLogSink;
 #ifndef WIN32
@@ -65,6 +69,60 @@ DENG2_PIMPL(LogBuffer)
     Time lastFlushedAt;
     QTimer *autoFlushTimer;
     Sinks sinks;
+    Lockable flushLock; ///< Serializes flushing and protects the sinks.
+
+    /**
+     * Formats and writes entries to the sinks in the background, so that threads
+     * adding entries never have to wait for the output.
+     */
+    class FlushThread : public QThread
+    {
+    public:
+        FlushThread(LogBuffer &buffer) : _buffer(buffer) {}
+
+        void run() override
+        {
+            for (;;)
+            {
+                _mutex.lock();
+                if (!_stopping && !_pending)
+                {
+                    _wakeUp.wait(&_mutex, (unsigned long) FLUSH_INTERVAL.asMilliSeconds());
+                }
+                bool const stopping = _stopping;
+                _pending = false;
+                _mutex.unlock();
+
+                _buffer.flush();
+                if (stopping) break;
+            }
+        }
+
+        void wake()
+        {
+            QMutexLocker locker(&_mutex);
+            _pending = true;
+            _wakeUp.wakeOne();
+        }
+
+        void stop()
+        {
+            {
+                QMutexLocker locker(&_mutex);
+                _stopping = true;
+                _wakeUp.wakeOne();
+            }
+            wait();
+        }
+
+    private:
+        LogBuffer &_buffer;
+        QMutex _mutex;
+        QWaitCondition _wakeUp;
+        bool _pending = false;
+        bool _stopping = false;
+    };
+    std::unique_ptr<FlushThread> flushThread;
 
     Impl(Public *i, duint maxEntryCount)
         : Base(i)
@@ -94,14 +152,24 @@ DENG2_PIMPL(LogBuffer)
 
     ~Impl()
     {
+        stopFlushThread();
         if (autoFlushTimer) autoFlushTimer->stop();
         delete fileLogSink;
     }
 
+    void stopFlushThread()
+    {
+        if (flushThread)
+        {
+            flushThread->stop();
+            flushThread.reset();
+        }
+    }
+
     void enableAutoFlush(bool yes)
     {
         DENG2_ASSERT(qApp);
-        if (yes)
+        if (yes && !flushThread)
         {
             if (!autoFlushTimer->isActive())
             {
@@ -161,6 +229,8 @@ LogBuffer::LogBuffer(duint maxEntryCount)
 
 LogBuffer::~LogBuffer()
 {
+    d->stopFlushThread();
+
     DENG2_GUARD(this);
 
     setOutputFile("");
@@ -171,16 +241,18 @@ LogBuffer::~LogBuffer()
 
 void LogBuffer::clear()
 {
-    DENG2_GUARD(this);
-
     // Flush first, we don't want to miss any messages.
     flush();
 
+    DENG2_GUARD_FOR(d->flushLock, flushing);
+    DENG2_GUARD(this);
+
     DENG2_FOR_EACH(Impl::EntryList, i, d->entries)
     {
         delete *i;
     }
     d->entries.clear();
+    d->toBeFlushed.clear(); // Deleted above.
 }
 
 dsize LogBuffer::size() const
@@ -233,22 +305,33 @@ void LogBuffer::setMaxEntryCount(duint maxEntryCount)
 
 void LogBuffer::add(LogEntry *entry)
 {
-    DENG2_GUARD(this);
+    bool overdue;
+    {
+        DENG2_GUARD(this);
+        overdue = d->lastFlushedAt.isValid() && d->lastFlushedAt.since() > FLUSH_INTERVAL;
+    }
 
     // We will not flush the new entry as it likely has not yet been given
     // all its arguments.
-    if (d->lastFlushedAt.isValid() && d->lastFlushedAt.since() > FLUSH_INTERVAL)
+    if (overdue && !d->flushThread)
     {
         flush();
     }
 
+    DENG2_GUARD(this);
+
     d->entries.push_back(entry);
     d->toBeFlushed.push_back(entry);
+
+    if (overdue && d->flushThread)
+    {
+        d->flushThread->wake();
+    }
 }
 
 void LogBuffer::enableStandardOutput(bool yes)
 {
-    DENG2_GUARD(this);
+    DENG2_GUARD_FOR(d->flushLock, flushing);
 
     d->useStandardOutput = yes;
 
@@ -269,15 +352,35 @@ void LogBuffer::setAutoFlushInterval(TimeSpan const &interval)
     d->autoFlushTimer->setInterval(interval.asMilliSeconds());
 }
 
-void LogBuffer::setOutputFile(String const &path, OutputChangeBehavior behavior)
+void LogBuffer::enableAsyncFlushing(bool yes)
 {
-    DENG2_GUARD(this);
+    if (yes && !d->flushThread)
+    {
+        d->flushThread.reset(new Impl::FlushThread(*this));
+        d->flushThread->start(QThread::LowPriority);
+        d->autoFlushTimer->stop();
+    }
+    else if (!yes && d->flushThread)
+    {
+        d->stopFlushThread();
+        d->enableAutoFlush(d->flushingEnabled);
+    }
+}
 
+bool LogBuffer::isAsyncFlushingEnabled() const
+{
+    return bool(d->flushThread);
+}
+
+void LogBuffer::setOutputFile(String const &path, OutputChangeBehavior behavior)
+{
     if (behavior == FlushFirstToOldOutputs)
     {
         flush();
     }
 
+    DENG2_GUARD_FOR(d->flushLock, flushing);
+
     d->disposeFileLogSink();
     d->outputPath = path;
     d->createFileLogSink(true /* truncated */);
@@ -290,14 +393,14 @@ String LogBuffer::outputFile() const
 
 void LogBuffer::addSink(LogSink &sink)
 {
-    DENG2_GUARD(this);
+    DENG2_GUARD_FOR(d->flushLock, flushing);
 
     d->sinks.insert(&sink);
 }
 
 void LogBuffer::removeSink(LogSink &sink)
 {
-    DENG2_GUARD(this);
+    DENG2_GUARD_FOR(d->flushLock, flushing);
 
     d->sinks.remove(&sink);
 }
@@ -306,11 +409,19 @@ void LogBuffer::flush()
 {
     if (!d->flushingEnabled) return;
 
-    DENG2_GUARD(this);
+    // Entries are formatted and written without holding the buffer lock, so other
+    // threads can keep adding entries meanwhile.
+    DENG2_GUARD_FOR(d->flushLock, flushing);
+
+    Impl::EntryList pending;
+    {
+        DENG2_GUARD(this);
+        pending.swap(d->toBeFlushed);
+    }
 
-    if (!d->toBeFlushed.isEmpty())
+    if (!pending.isEmpty())
     {
-        DENG2_FOR_EACH(Impl::EntryList, i, d->toBeFlushed)
+        DENG2_FOR_EACH(Impl::EntryList, i, pending)
         {
             DENG2_GUARD_FOR(**i, guardingCurrentLogEntry);
             foreach (LogSink *sink, d->sinks)
@@ -331,16 +442,19 @@ void LogBuffer::flush()
             }
         }
 
-        d->toBeFlushed.clear();
-
         // Make sure everything really gets written now.
         foreach (LogSink *sink, d->sinks) sink->flush();
     }
 
+    DENG2_GUARD(this);
+
     d->lastFlushedAt = Time();
 
-    // Too many entries? Now they can be destroyed since we have flushed everything.
-    while (d->entries.size() > d->maxEntryCount)
+    // Too many entries? Now they can be destroyed since we have flushed them.
+    // Entries added while flushing are still waiting in toBeFlushed; they are the
+    // newest ones and must be kept until the next flush.
+    while (d->entries.size() > d->maxEntryCount &&
+           d->entries.size() > d->toBeFlushed.size())
     {
         LogEntry *old = d->entries.front();
         d->entries.pop_front();
@@ -17,6 +17,8 @@
  */
 
 #include "de/Bank"
+#include "de/BlockStore"
+#include "de/DirectoryFeed"
 #include "de/Folder"
 #include "de/App"
 #include "de/Loop"
@@ -35,6 +37,8 @@
 
 namespace de {
 
+static char const *STORE_FILE_NAME = "hotstorage.store";
+
 namespace internal {
 
 /**
@@ -130,13 +134,14 @@ DENG2_PIMPL(Bank)
         Bank *bank;                     ///< Bank that owns the data.
         std::unique_ptr<IData> data;    ///< Non-NULL for in-memory items.
         std::unique_ptr<ISource> source;///< Always required.
-        SafePtr<File> serial;           ///< Serialized representation (if one is present; not owned).
+        bool serialized;                ///< Serialized representation is present in hot storage.
         Cache *cache;                   ///< Current cache for the data (never NULL).
         Time accessedAt;
 
         Data(PathTree::NodeArgs const &args)
             : Node(args)
             , bank(0)
+            , serialized(false)
             , cache(0)
             , accessedAt(Time::invalidTime())
         {}
@@ -205,6 +210,12 @@ DENG2_PIMPL(Bank)
             }
         }
 
+        /// Key of the item in the hot storage.
+        Block serialKey() const
+        {
+            return path().toString().toUtf8();
+        }
+
         bool isValidSerialTime(Time const &serialTime) const
         {
             return (!source->modifiedAt().isValid() ||
@@ -213,14 +224,15 @@ DENG2_PIMPL(Bank)
 
         void loadFromSerialized()
         {
-            DENG2_ASSERT(serial);
+            DENG2_ASSERT(serialized);
 
             try
             {
                 Time startedAt;
 
                 Time timestamp(Time::invalidTime());
-                Reader reader(*serial);
+                Block const serialData = bank->d->serialCache->store().value(serialKey());
+                Reader reader(serialData);
                 reader.withHeader() >> timestamp;
 
                 if (isValidSerialTime(timestamp))
@@ -244,11 +256,11 @@ DENG2_PIMPL(Bank)
             loadFromSource();
         }
 
-        void serialize(Path const &folderPath)
+        void serialize(BlockStore &store)
         {
             DENG2_GUARD(this);
 
-            if (serial)
+            if (serialized)
             {
                 // Already serialized.
                 return;
@@ -264,45 +276,34 @@ DENG2_PIMPL(Bank)
 
             DENG2_ASSERT(data->asSerializable() != 0);
 
-            try
+            if (!data->shouldBeSerialized())
             {
-                // Make sure the correct folder exists.
-                Folder &containingFolder = FileSystem::get()
-                        .makeFolder(folderPath / path().toString().fileNamePath());
-
-                if (!data->shouldBeSerialized())
+                // Not necessary; the serialized version already exists?
+                if (store.contains(serialKey()))
                 {
-                    // Not necessary; the serialized version already exists?
-                    if (File *existing = containingFolder.tryLocate<File>(name()))
-                    {
-                        serial.reset(existing);
-                        return;
-                    }
+                    serialized = true;
+                    return;
                 }
-
-                // Source timestamp is included in the serialization
-                // to check later whether the data is still fresh.
-                serial.reset(&containingFolder.createFile(name(), Folder::ReplaceExisting));
-
-                LOG_XVERBOSE("Serializing into %s", serial->description());
-
-                Writer(*serial).withHeader()
-                        << source->modifiedAt()
-                        << *data->asSerializable();
-                serial->flush();
-            }
-            catch (...)
-            {
-                serial.reset();
-                throw;
             }
+
+            LOG_XVERBOSE("Serializing \"%s\" into %s",
+                         path(bank->d->sepChar) << store.filePath().pretty());
+
+            // Source timestamp is included in the serialization
+            // to check later whether the data is still fresh.
+            Block buf;
+            Writer(buf).withHeader()
+                    << source->modifiedAt()
+                    << *data->asSerializable();
+            store.set(serialKey(), buf);
+            serialized = true;
         }
 
         void clearSerialized()
         {
             DENG2_GUARD(this);
 
-            serial.reset();
+            serialized = false;
         }
 
         void changeCache(Cache &toCache)
@@ -339,8 +340,13 @@ DENG2_PIMPL(Bank)
     };
 
     /**
-     * Hot storage containing data items serialized into files. The goal is to
-     * allow quick recovery of data into memory. May be disabled in a Bank.
+     * Hot storage containing serialized data items. The goal is to allow quick
+     * recovery of data into memory. May be disabled in a Bank.
+     *
+     * All the items are kept in a single BlockStore file in a bank-specific
+     * subfolder of the hot storage location, so that the cached data of thousands
+     * of items can be accessed without opening as many files. The location may be
+     * shared with other banks and other users of the file system.
      */
     class SerializedCache : public DataCache
     {
@@ -351,9 +357,9 @@ DENG2_PIMPL(Bank)
         {
             DENG2_GUARD(this);
 
-            DENG2_ASSERT(!_path.isEmpty());
-            item.serialize(_path);
-            addBytes(item.serial->size());
+            DENG2_ASSERT(_store);
+            item.serialize(*_store);
+            addBytes(_store->valueSize(item.serialKey()));
             DataCache::add(item);
         }
 
@@ -361,18 +367,57 @@ DENG2_PIMPL(Bank)
         {
             DENG2_GUARD(this);
 
-            addBytes(-dint64(item.serial->size()));
+            addBytes(-dint64(_store->valueSize(item.serialKey())));
             item.clearSerialized();
             DataCache::remove(item);
         }
 
-        void setLocation(String const &location)
+        void setLocation(String const &location, String const &bankName)
         {
             DENG2_ASSERT(!location.isEmpty());
             DENG2_GUARD(this);
 
             // Serialized "hot" data is kept here.
-            _path = location;
+            _legacyPath = location;
+            _path = location / bankName;
+            _store.reset();
+
+            Folder &folder = FS::get().makeFolder(_path);
+            if (auto *feed = folder.primaryFeedMaybeAs<DirectoryFeed>())
+            {
+                NativePath const storePath = feed->nativePath() / STORE_FILE_NAME;
+
+                // Items used to be serialized into individual files directly in the
+                // location. These are removed as the items are added to the bank.
+                _removeLegacyFiles = !storePath.exists();
+
+                _store.reset(new BlockStore(storePath));
+            }
+        }
+
+        /**
+         * Deletes the file where the old hot storage layout kept @a item, if one
+         * exists. Nothing else in the location is touched.
+         */
+        void removeLegacyFile(Data const &item)
+        {
+            if (!_removeLegacyFiles) return;
+
+            if (File *legacy = FS::tryLocate<File>(_legacyPath / item.path()))
+            {
+                if (Folder *parent = legacy->parent())
+                {
+                    try
+                    {
+                        parent->destroyFile(legacy->name());
+                    }
+                    catch (Error const &er)
+                    {
+                        LOGDEV_RES_WARNING("Failed to remove old hot storage file %s: %s")
+                                << legacy->description() << er.asText();
+                    }
+                }
+            }
         }
 
         Path const &path() const
@@ -385,8 +430,22 @@ DENG2_PIMPL(Bank)
             return FS::tryLocate<Folder>(_path);
         }
 
+        bool hasStore() const
+        {
+            return bool(_store);
+        }
+
+        BlockStore &store()
+        {
+            DENG2_ASSERT(_store);
+            return *_store;
+        }
+
     private:
         Path _path;
+        Path _legacyPath;
+        bool _removeLegacyFiles = false;
+        std::unique_ptr<BlockStore> _store;
     };
 
     /**
@@ -564,16 +623,15 @@ DENG2_PIMPL(Bank)
     }
 
     /**
-     * Deletes everything in the hot storage folder.
+     * Deletes everything in the hot storage.
      */
     void clearHotStorage()
     {
         DENG2_ASSERT(serialCache);
 
-        FS::waitForIdle();
-        if (Folder *folder = serialCache->folder())
+        if (serialCache->hasStore())
         {
-            folder->destroyAllFilesRecursively();
+            serialCache->store().clear();
         }
     }
 
@@ -633,11 +691,19 @@ DENG2_PIMPL(Bank)
         else
         {
             if (!serialCache) serialCache.reset(new SerializedCache);
-            serialCache->setLocation(location);
-
-            // Make sure that the cache folder is immediately populated so that the
-            // cached data available for future operations.
-            FS::get().makeFolder(location);
+            try
+            {
+                serialCache->setLocation(location, nameForLog);
+            }
+            catch (Error const &er)
+            {
+                LOG_WARNING("%s hot storage is unavailable: %s") << nameForLog << er.asText();
+            }
+            if (!serialCache->hasStore())
+            {
+                // Hot storage requires a native folder.
+                serialCache.reset();
+            }
         }
     }
 
@@ -650,18 +716,20 @@ DENG2_PIMPL(Bank)
 
         if (serialCache)
         {
+            serialCache->removeLegacyFile(item);
+
             // Check if this item is already available in hot storage.
-            File *src = FS::tryLocate<File>(serialCache->path() / item.path());
-            if (src)
+            Block const hot = serialCache->store().value(item.serialKey());
+            if (!hot.isEmpty())
             {
                 Time hotTime;
-                Reader(*src).withHeader() >> hotTime;
+                Reader(hot).withHeader() >> hotTime;
 
                 if (item.isValidSerialTime(hotTime))
                 {
                     LOGDEV_RES_VERBOSE("Found valid serialized copy of \"%s\"") << item.path(sepChar);
 
-                    item.serial.reset(src);
+                    item.serialized = true;
                     best = serialCache.get();
                 }
             }
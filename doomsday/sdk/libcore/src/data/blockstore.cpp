@@ -0,0 +1,651 @@
+/** @file blockstore.cpp  Persistent single-file key/value store.
+ *
+ * @authors Copyright © 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/BlockStore"
+#include "de/ByteRefArray"
+#include "de/Log"
+#include "de/Reader"
+#include "de/TaskPool"
+#include "de/Writer"
+#include "de/math.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QSaveFile>
+
+namespace de {
+
+/*
+ * Data file:  magic, version, generation, followed by records.
+ * Record:     key size, value size (or REMOVED), CRC-32 of key and value, key, value.
+ * Index file: magic, version, generation, covered data size, garbage size, entry
+ *             count, entries (key size, key, value offset, value size), CRC-32.
+ */
+static duint32 const DATA_MAGIC         = 0x53424544; // "DEBS"
+static duint32 const INDEX_MAGIC        = 0x49424544; // "DEBI"
+static duint32 const FORMAT_VERSION     = 1;
+static dsize   const HEADER_SIZE        = 4 + 4 + 8;
+static dsize   const RECORD_HEADER_SIZE = 4 + 4 + 4;
+static duint32 const REMOVED            = 0xffffffff;
+
+/// Compaction is started when at least half of the data file is garbage.
+static dsize const MIN_GARBAGE_FOR_COMPACTION = 1024 * 1024;
+
+DENG2_PIMPL_NOREF(BlockStore), public Lockable
+{
+    struct Entry
+    {
+        duint64 offset; ///< Offset of the value in the data file.
+        duint32 size;
+    };
+    typedef QHash<Block, Entry> Index;
+
+    NativePath filePath;
+    QFile file;
+    uchar *mapped = nullptr;
+    dsize mappedSize = 0;
+    duint64 generation = 0;
+    dsize fileSize = 0;     ///< End of the valid records.
+    dsize garbage = 0;
+    Index index;
+    bool indexChanged = false;
+    bool compacting = false;
+    int compactionCount = 0;
+    TaskPool tasks;
+
+    ~Impl()
+    {
+        unmap();
+    }
+
+    NativePath indexPath() const
+    {
+        return filePath.toString() + ".index";
+    }
+
+    static dsize recordSize(dsize keySize, dsize valueSize)
+    {
+        return RECORD_HEADER_SIZE + keySize + valueSize;
+    }
+
+    duint64 newGeneration() const
+    {
+        return de::max(generation + 1, duint64(QDateTime::currentMSecsSinceEpoch()));
+    }
+
+    void unmap()
+    {
+        if (mapped)
+        {
+            file.unmap(mapped);
+            mapped = nullptr;
+        }
+        mappedSize = 0;
+    }
+
+    void remap()
+    {
+        unmap();
+        if (file.size() > 0)
+        {
+            // If mapping fails, values are read from the file instead.
+            mapped = file.map(0, file.size());
+            if (mapped) mappedSize = dsize(file.size());
+        }
+    }
+
+    Block readAt(dsize offset, dsize size)
+    {
+        if (mapped && offset + size <= mappedSize)
+        {
+            return Block(mapped + offset, size);
+        }
+        file.seek(qint64(offset));
+        return Block(file.read(qint64(size)));
+    }
+
+    void open()
+    {
+        file.setFileName(filePath.toString());
+        if (!file.open(QFile::ReadWrite))
+        {
+            throw OpenError("BlockStore::open", "Failed to open \"" + filePath.pretty() +
+                            "\": " + file.errorString());
+        }
+        remap();
+
+        if (!readHeader())
+        {
+            initialize();
+            return;
+        }
+        dsize const covered = loadIndex();
+        if (!covered)
+        {
+            index.clear();
+            garbage = 0;
+        }
+        scan(covered? covered : HEADER_SIZE);
+    }
+
+    bool readHeader()
+    {
+        if (dsize(file.size()) < HEADER_SIZE) return false;
+
+        duint32 magic, version;
+        Reader(readAt(0, HEADER_SIZE)) >> magic >> version >> generation;
+        return magic == DATA_MAGIC && version == FORMAT_VERSION;
+    }
+
+    /// Truncates the data file and writes a new header.
+    void initialize()
+    {
+        unmap();
+        generation = newGeneration();
+
+        Block header;
+        Writer(header) << DATA_MAGIC << FORMAT_VERSION << generation;
+        file.resize(0);
+        file.seek(0);
+        write(header);
+
+        fileSize = HEADER_SIZE;
+        garbage = 0;
+        index.clear();
+        indexChanged = true;
+        remap();
+    }
+
+    void write(Block const &data)
+    {
+        if (file.write(data) != qint64(data.size()))
+        {
+            throw WriteError("BlockStore::write", "Failed to write \"" + filePath.pretty() +
+                             "\": " + file.errorString());
+        }
+        file.flush();
+    }
+
+    /**
+     * Reads the index file.
+     *
+     * @return Size of the data covered by the index, or zero if the index could not
+     * be used.
+     */
+    dsize loadIndex()
+    {
+        QFile idx(indexPath().toString());
+        if (!idx.open(QFile::ReadOnly) || idx.size() < 4) return 0;
+
+        dsize const size = dsize(idx.size());
+        Block contents;
+        uchar const *ptr = idx.map(0, qint64(size));
+        if (!ptr)
+        {
+            contents = idx.readAll();
+            ptr = contents.dataConst();
+        }
+        ByteRefArray const bytes(ptr, size);
+
+        dsize covered = 0;
+        try
+        {
+            duint32 checksum;
+            Reader check(bytes);
+            check.setOffset(size - 4);
+            check >> checksum;
+            if (crc32(ByteRefArray(ptr, size - 4)) != checksum) return 0;
+
+            duint32 magic, version, count;
+            duint64 indexGeneration, indexCovered, indexGarbage;
+            Reader reader(bytes);
+            reader >> magic >> version >> indexGeneration >> indexCovered >> indexGarbage >> count;
+            if (magic != INDEX_MAGIC || version != FORMAT_VERSION ||
+                indexGeneration != generation || indexCovered > duint64(file.size()))
+            {
+                return 0;
+            }
+
+            Index loaded;
+            loaded.reserve(int(count));
+            for (duint32 i = 0; i < count; ++i)
+            {
+                duint32 keySize;
+                reader >> keySize;
+                if (reader.remainingSize() < keySize) return 0;
+                Block const key(ptr + reader.offset(), keySize);
+                reader.seek(keySize);
+
+                Entry entry;
+                reader >> entry.offset >> entry.size;
+                if (entry.offset + entry.size > indexCovered) return 0;
+                loaded.insert(key, entry);
+            }
+            index   = loaded;
+            garbage = dsize(indexGarbage);
+            covered = dsize(indexCovered);
+        }
+        catch (Error const &er)
+        {
+            LOG_AS("BlockStore");
+            LOGDEV_RES_WARNING("Index of \"%s\" is unusable: %s")
+                    << filePath.pretty() << er.asText();
+            return 0;
+        }
+        if (!contents.size()) idx.unmap(const_cast<uchar *>(ptr));
+        return covered;
+    }
+
+    void writeIndex()
+    {
+        Block buf;
+        Writer writer(buf);
+        writer << INDEX_MAGIC << FORMAT_VERSION << generation
+               << duint64(fileSize) << duint64(garbage) << duint32(index.size());
+        for (auto i = index.constBegin(); i != index.constEnd(); ++i)
+        {
+            writer << duint32(i.key().size());
+            writer.writeBytes(i.key());
+            writer << i.value().offset << i.value().size;
+        }
+        writer << crc32(buf);
+
+        QSaveFile out(indexPath().toString());
+        if (!out.open(QFile::WriteOnly) ||
+            out.write(buf) != qint64(buf.size()) ||
+            !out.commit())
+        {
+            throw WriteError("BlockStore::writeIndex", "Failed to write \"" +
+                             indexPath().pretty() + "\": " + out.errorString());
+        }
+        indexChanged = false;
+    }
+
+    /**
+     * Reads the records starting at @a pos into the index. Reading stops at the first
+     * incomplete or corrupt record, and the rest of the file is discarded.
+     */
+    void scan(dsize pos)
+    {
+        dsize const end = dsize(file.size());
+        while (pos + RECORD_HEADER_SIZE <= end)
+        {
+            duint32 keySize, valueSize, checksum;
+            Reader(readAt(pos, RECORD_HEADER_SIZE)) >> keySize >> valueSize >> checksum;
+
+            duint64 const payloadSize = duint64(keySize) + (valueSize == REMOVED? 0 : valueSize);
+            if (pos + RECORD_HEADER_SIZE + payloadSize > end) break;
+
+            Block const payload = readAt(pos + RECORD_HEADER_SIZE, dsize(payloadSize));
+            if (crc32(payload) != checksum) break;
+
+            Block const key(payload, 0, keySize);
+            if (valueSize == REMOVED)
+            {
+                apply(key, nullptr);
+            }
+            else
+            {
+                Entry const entry { pos + RECORD_HEADER_SIZE + keySize, valueSize };
+                apply(key, &entry);
+            }
+            pos += RECORD_HEADER_SIZE + dsize(payloadSize);
+            indexChanged = true;
+        }
+        if (pos < end)
+        {
+            LOG_AS("BlockStore");
+            LOG_RES_WARNING("Discarding %i bytes of incomplete data at the end of \"%s\"")
+                    << end - pos << filePath.pretty();
+            unmap();
+            file.resize(qint64(pos));
+            remap();
+        }
+        fileSize = pos;
+    }
+
+    /// Updates the index with a new record, keeping track of the garbage.
+    void apply(Block const &key, Entry const *entry)
+    {
+        auto found = index.find(key);
+        if (found != index.end())
+        {
+            garbage += recordSize(dsize(key.size()), found.value().size);
+        }
+        if (entry)
+        {
+            index.insert(key, *entry);
+        }
+        else
+        {
+            if (found != index.end()) index.erase(found);
+            // The removal record itself is garbage.
+            garbage += recordSize(dsize(key.size()), 0);
+        }
+    }
+
+    static Block makeRecord(Block const &key, Block const *value)
+    {
+        Block payload = key;
+        if (value) payload += *value;
+
+        Block record;
+        Writer(record) << duint32(key.size())
+                       << duint32(value? duint32(value->size()) : REMOVED)
+                       << crc32(payload);
+        record += payload;
+        return record;
+    }
+
+    void append(Block const &key, Block const *value)
+    {
+        Block const record = makeRecord(key, value);
+        file.seek(qint64(fileSize));
+        write(record);
+
+        if (value)
+        {
+            Entry const entry { fileSize + RECORD_HEADER_SIZE + key.size(), duint32(value->size()) };
+            apply(key, &entry);
+        }
+        else
+        {
+            apply(key, nullptr);
+        }
+        fileSize += dsize(record.size());
+        indexChanged = true;
+
+        if (!compacting && garbage >= MIN_GARBAGE_FOR_COMPACTION && garbage * 2 >= fileSize)
+        {
+            compacting = true;
+            tasks.start([this] () { compactInBackground(); }, TaskPool::LowPriority);
+        }
+    }
+
+    void compactInBackground()
+    {
+        try
+        {
+            compact();
+        }
+        catch (Error const &er)
+        {
+            LOG_AS("BlockStore");
+            LOG_RES_WARNING("Failed to compact \"%s\": %s") << filePath.pretty() << er.asText();
+
+            DENG2_GUARD(this);
+            compacting = false;
+        }
+    }
+
+    /**
+     * Writes the current entries to a new data file that replaces the old one. The
+     * entries are copied without holding the lock, so the store remains usable
+     * meanwhile; changes made during the copy are applied at the end. The caller
+     * must first set @c compacting.
+     */
+    void compact()
+    {
+        Index snapshot;
+        dsize snapshotEnd;
+        {
+            DENG2_GUARD(this);
+            DENG2_ASSERT(compacting);
+            remap(); // The records that exist now won't change.
+            snapshot = index;
+            snapshotEnd = fileSize;
+        }
+
+        QSaveFile out(filePath.toString());
+        if (!out.open(QFile::WriteOnly))
+        {
+            throw WriteError("BlockStore::compact", "Failed to create a new \"" +
+                             filePath.pretty() + "\": " + out.errorString());
+        }
+        duint64 const compactedGeneration = newGeneration();
+        Index compacted;
+        compacted.reserve(snapshot.size());
+        dsize pos = HEADER_SIZE;
+        dsize compactedGarbage = 0;
+
+        auto output = [this, &out, &pos] (Block const &data)
+        {
+            if (out.write(data) != qint64(data.size()))
+            {
+                throw WriteError("BlockStore::compact", "Failed to write a new \"" +
+                                 filePath.pretty() + "\": " + out.errorString());
+            }
+            pos += dsize(data.size());
+        };
+        auto copyEntry = [this, &output, &pos, &compacted, &compactedGarbage]
+                (Block const &key, Block const &value)
+        {
+            auto found = compacted.find(key);
+            if (found != compacted.end())
+            {
+                compactedGarbage += recordSize(dsize(key.size()), found.value().size);
+            }
+            compacted.insert(key, Entry { pos + RECORD_HEADER_SIZE + key.size(),
+                                          duint32(value.size()) });
+            output(makeRecord(key, &value));
+        };
+
+        {
+            Block header;
+            Writer(header) << DATA_MAGIC << FORMAT_VERSION << compactedGeneration;
+            output(header);
+        }
+        for (auto i = snapshot.constBegin(); i != snapshot.constEnd(); ++i)
+        {
+            Entry const &entry = i.value();
+            if (mapped && entry.offset + entry.size <= mappedSize)
+            {
+                copyEntry(i.key(), ByteRefArray(mapped + entry.offset, entry.size));
+            }
+            else
+            {
+                DENG2_GUARD(this);
+                copyEntry(i.key(), readAt(entry.offset, entry.size));
+            }
+        }
+
+        DENG2_GUARD(this);
+
+        // Apply the changes that were made during the copy.
+        for (auto i = index.constBegin(); i != index.constEnd(); ++i)
+        {
+            if (i.value().offset >= snapshotEnd)
+            {
+                copyEntry(i.key(), readAt(i.value().offset, i.value().size));
+            }
+        }
+        for (auto i = snapshot.constBegin(); i != snapshot.constEnd(); ++i)
+        {
+            if (!index.contains(i.key()))
+            {
+                auto found = compacted.find(i.key());
+                compactedGarbage += recordSize(dsize(i.key().size()), found.value().size) +
+                                    recordSize(dsize(i.key().size()), 0);
+                compacted.erase(found);
+                output(makeRecord(i.key(), nullptr));
+            }
+        }
+
+        // Replace the old data file.
+        unmap();
+        file.close();
+        bool const committed = out.commit();
+        if (!file.open(QFile::ReadWrite))
+        {
+            throw OpenError("BlockStore::compact", "Failed to reopen \"" + filePath.pretty() +
+                            "\": " + file.errorString());
+        }
+        if (committed)
+        {
+            index      = compacted;
+            generation = compactedGeneration;
+            fileSize   = pos;
+            garbage    = compactedGarbage;
+            compactionCount++;
+            writeIndex();
+        }
+        remap();
+        compacting = false;
+
+        if (!committed)
+        {
+            throw WriteError("BlockStore::compact", "Failed to replace \"" +
+                             filePath.pretty() + "\": " + out.errorString());
+        }
+    }
+};
+
+BlockStore::BlockStore(NativePath const &filePath)
+    : d(new Impl)
+{
+    d->filePath = filePath;
+    d->open();
+}
+
+BlockStore::~BlockStore()
+{
+    d->tasks.waitForDone();
+
+    // Musn't throw exceptions from destructor...
+    try
+    {
+        flush();
+    }
+    catch (Error const &er)
+    {
+        LOG_AS("~BlockStore");
+        LOG_RES_WARNING("\"%s\" index could not be written: %s")
+                << d->filePath.pretty() << er.asText();
+    }
+}
+
+NativePath BlockStore::filePath() const
+{
+    return d->filePath;
+}
+
+bool BlockStore::contains(Block const &key) const
+{
+    DENG2_GUARD(d);
+    return d->index.contains(key);
+}
+
+Block BlockStore::value(Block const &key) const
+{
+    DENG2_GUARD(d);
+    auto found = d->index.constFind(key);
+    if (found == d->index.constEnd()) return Block();
+    return d->readAt(found.value().offset, found.value().size);
+}
+
+dsize BlockStore::valueSize(Block const &key) const
+{
+    DENG2_GUARD(d);
+    auto found = d->index.constFind(key);
+    if (found == d->index.constEnd()) return 0;
+    return found.value().size;
+}
+
+QList<Block> BlockStore::keys() const
+{
+    DENG2_GUARD(d);
+    return d->index.keys();
+}
+
+void BlockStore::set(Block const &key, Block const &value)
+{
+    DENG2_GUARD(d);
+    d->append(key, &value);
+}
+
+void BlockStore::remove(Block const &key)
+{
+    DENG2_GUARD(d);
+    if (d->index.contains(key))
+    {
+        d->append(key, nullptr);
+    }
+}
+
+void BlockStore::clear()
+{
+    for (;;)
+    {
+        d->tasks.waitForDone();
+
+        DENG2_GUARD(d);
+        if (d->compacting) continue;
+
+        d->initialize();
+        d->writeIndex();
+        return;
+    }
+}
+
+void BlockStore::flush()
+{
+    DENG2_GUARD(d);
+    if (d->indexChanged)
+    {
+        d->writeIndex();
+    }
+}
+
+void BlockStore::compact()
+{
+    for (;;)
+    {
+        d->tasks.waitForDone();
+
+        DENG2_GUARD(d);
+        if (!d->compacting)
+        {
+            d->compacting = true;
+            break;
+        }
+    }
+    try
+    {
+        d->compact();
+    }
+    catch (...)
+    {
+        DENG2_GUARD(d);
+        d->compacting = false;
+        throw;
+    }
+}
+
+BlockStore::Statistics BlockStore::statistics() const
+{
+    DENG2_GUARD(d);
+    Statistics stats;
+    stats.entryCount      = d->index.size();
+    stats.fileSize        = d->fileSize;
+    stats.garbageSize     = d->garbage;
+    stats.compactionCount = d->compactionCount;
+    return stats;
+}
+
+} // namespace de
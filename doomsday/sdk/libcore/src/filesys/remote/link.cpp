@@ -196,6 +196,11 @@ void Link::handleError(QString errorMessage)
             << errorMessage;
 }
 
+bool Link::supportsChunkedTransfers() const
+{
+    return false;
+}
+
 AsyncScope &Link::scope()
 {
     return *d;
@@ -307,5 +312,18 @@ void Link::chunkReceived(QueryId id, duint64 startOffset, Block const &chunk, du
     }
 }
 
+void Link::manifestReceived(QueryId id, duint64 fileSize, dsize chunkSize,
+                            QList<Block> const &chunkHashes)
+{
+    if (auto *query = findQuery(id))
+    {
+        if (query->fileManifest)
+        {
+            query->fileManifest->call(fileSize, chunkSize, chunkHashes);
+        }
+        d->pendingQueries.remove(id);
+    }
+}
+
 } // namespace filesys
 } // namespace de
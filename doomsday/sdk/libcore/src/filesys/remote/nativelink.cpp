@@ -65,6 +65,11 @@ DENG2_PIMPL(NativeLink)
                     self().chunkReceived(fc.id(), fc.startOffset(), fc.data(), fc.fileSize());
                     break; }
 
+                case RemoteFeedProtocol::Manifest: {
+                    auto const &mf = packet->as<RemoteFeedManifestPacket>();
+                    self().manifestReceived(mf.id(), mf.fileSize(), mf.chunkSize(), mf.chunkHashes());
+                    break; }
+
                 default:
                     break;
                 }
@@ -140,6 +145,11 @@ LoopResult filesys::NativeLink::forPackageIds(std::function<LoopResult (String c
     });
 }
 
+bool NativeLink::supportsChunkedTransfers() const
+{
+    return true;
+}
+
 void NativeLink::wasConnected()
 {
     d->socket << ByteRefArray("RemoteFeed", 10);
@@ -157,6 +167,16 @@ void NativeLink::transmit(Query const &query)
     {
         packet.setQuery(RemoteFeedQueryPacket::ListFiles);
     }
+    else if (query.fileManifest)
+    {
+        packet.setQuery(RemoteFeedQueryPacket::FileManifest);
+        packet.setChunkSize(query.chunkSize);
+    }
+    else if (query.fileContents && query.rangeSize > 0)
+    {
+        packet.setQuery(RemoteFeedQueryPacket::FileRange);
+        packet.setRange(query.rangeOffset, query.rangeSize);
+    }
     else if (query.fileContents)
     {
         packet.setQuery(RemoteFeedQueryPacket::FileContents);
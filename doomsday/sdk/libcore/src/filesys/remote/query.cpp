@@ -29,10 +29,19 @@ Query::Query(Request<FileContents> req, String path)
     : path(path), fileContents(req)
 {}
 
+Query::Query(Request<FileContents> req, String path, duint64 rangeOffset, duint64 rangeSize)
+    : path(path), rangeOffset(rangeOffset), rangeSize(rangeSize), fileContents(req)
+{}
+
+Query::Query(Request<FileManifest> req, String path, dsize chunkSize)
+    : path(path), chunkSize(chunkSize), fileManifest(req)
+{}
+
 bool Query::isValid() const
 {
     if (fileMetadata) return fileMetadata->isValid();
     if (fileContents) return fileContents->isValid();
+    if (fileManifest) return fileManifest->isValid();
     return false;
 }
 
@@ -40,6 +49,7 @@ void Query::cancel()
 {
     if (fileMetadata) fileMetadata->cancel();
     if (fileContents) fileContents->cancel();
+    if (fileManifest) fileManifest->cancel();
 }
 
 } // namespace filesys
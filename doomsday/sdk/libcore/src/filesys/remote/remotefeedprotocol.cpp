@@ -47,21 +47,63 @@ RemoteFeedQueryPacket::Query RemoteFeedQueryPacket::query() const
     return _query;
 }
 
+void RemoteFeedQueryPacket::setRange(duint64 offset, duint64 size)
+{
+    _rangeOffset = offset;
+    _rangeSize   = size;
+}
+
+void RemoteFeedQueryPacket::setChunkSize(dsize chunkSize)
+{
+    _chunkSize = chunkSize;
+}
+
 String RemoteFeedQueryPacket::path() const
 {
     return _path;
 }
 
+duint64 RemoteFeedQueryPacket::rangeOffset() const
+{
+    return _rangeOffset;
+}
+
+duint64 RemoteFeedQueryPacket::rangeSize() const
+{
+    return _rangeSize;
+}
+
+dsize RemoteFeedQueryPacket::chunkSize() const
+{
+    return _chunkSize;
+}
+
 void RemoteFeedQueryPacket::operator >> (Writer &to) const
 {
     IdentifiedPacket::operator >> (to);
     to << duint8(_query) << _path;
+    if (_query == FileManifest)
+    {
+        to << duint32(_chunkSize);
+    }
+    else if (_query == FileRange)
+    {
+        to << _rangeOffset << _rangeSize;
+    }
 }
 
 void RemoteFeedQueryPacket::operator << (Reader &from)
 {
     IdentifiedPacket::operator << (from);
     from.readAs<duint8>(_query) >> _path;
+    if (_query == FileManifest)
+    {
+        from.readAs<duint32>(_chunkSize);
+    }
+    else if (_query == FileRange)
+    {
+        from >> _rangeOffset >> _rangeSize;
+    }
 }
 
 Packet *RemoteFeedQueryPacket::fromBlock(Block const &block)
@@ -204,6 +246,79 @@ Packet *RemoteFeedFileContentsPacket::fromBlock(Block const &block)
     return constructFromBlock<RemoteFeedFileContentsPacket>(block, FILE_CONTENTS_PACKET_TYPE);
 }
 
+// RemoteFeedManifestPacket -------------------------------------------------------------
+
+static Packet::Type const MANIFEST_PACKET_TYPE = Packet::typeFromString("RFMf");
+
+RemoteFeedManifestPacket::RemoteFeedManifestPacket()
+    : IdentifiedPacket(MANIFEST_PACKET_TYPE)
+{}
+
+void RemoteFeedManifestPacket::setFileSize(duint64 size)
+{
+    _fileSize = size;
+}
+
+void RemoteFeedManifestPacket::setChunkSize(dsize chunkSize)
+{
+    _chunkSize = chunkSize;
+}
+
+void RemoteFeedManifestPacket::setChunkHashes(QList<Block> const &hashes)
+{
+    _hashes = hashes;
+}
+
+duint64 RemoteFeedManifestPacket::fileSize() const
+{
+    return _fileSize;
+}
+
+dsize RemoteFeedManifestPacket::chunkSize() const
+{
+    return _chunkSize;
+}
+
+QList<Block> const &RemoteFeedManifestPacket::chunkHashes() const
+{
+    return _hashes;
+}
+
+void RemoteFeedManifestPacket::operator >> (Writer &to) const
+{
+    IdentifiedPacket::operator >> (to);
+    to << _fileSize << duint32(_chunkSize) << duint32(_hashes.size());
+    for (Block const &hash : _hashes)
+    {
+        to << hash;
+    }
+}
+
+void RemoteFeedManifestPacket::operator << (Reader &from)
+{
+    IdentifiedPacket::operator << (from);
+    duint32 count;
+    from >> _fileSize;
+    from.readAs<duint32>(_chunkSize) >> count;
+    _hashes.clear();
+    while (count-- > 0)
+    {
+        Block hash;
+        from >> hash;
+        _hashes << hash;
+    }
+}
+
+Packet *RemoteFeedManifestPacket::fromBlock(Block const &block)
+{
+    return constructFromBlock<RemoteFeedManifestPacket>(block, MANIFEST_PACKET_TYPE);
+}
+
+Block RemoteFeedManifestPacket::chunkHash(IByteArray const &chunk)
+{
+    return Block(chunk).md5Hash();
+}
+
 // RemoteFeedProtocol -------------------------------------------------------------------
 
 RemoteFeedProtocol::RemoteFeedProtocol()
@@ -211,6 +326,7 @@ RemoteFeedProtocol::RemoteFeedProtocol()
     define(RemoteFeedQueryPacket::fromBlock);
     define(RemoteFeedMetadataPacket::fromBlock);
     define(RemoteFeedFileContentsPacket::fromBlock);
+    define(RemoteFeedManifestPacket::fromBlock);
 }
 
 RemoteFeedProtocol::PacketType RemoteFeedProtocol::recognize(Packet const &packet)
@@ -230,6 +346,11 @@ RemoteFeedProtocol::PacketType RemoteFeedProtocol::recognize(Packet const &packe
         DENG2_ASSERT(is<RemoteFeedFileContentsPacket>(&packet));
         return FileContents;
     }
+    if (packet.type() == MANIFEST_PACKET_TYPE)
+    {
+        DENG2_ASSERT(is<RemoteFeedManifestPacket>(&packet));
+        return Manifest;
+    }
     return Unknown;
 }
 
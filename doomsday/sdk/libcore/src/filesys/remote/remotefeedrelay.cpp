@@ -20,13 +20,17 @@
 
 #include "de/App"
 #include "de/Async"
+#include "de/BlockStore"
 #include "de/Date"
 #include "de/DictionaryValue"
+#include "de/DirectoryFeed"
+#include "de/FileSystem"
 #include "de/filesys/Link"
 #include "de/filesys/NativeLink"
 #include "de/Loop"
 #include "de/Message"
 #include "de/RemoteFeedProtocol"
+#include "de/RemoteFile"
 #include "de/Version"
 #include "de/charsymbols.h"
 
@@ -41,11 +45,56 @@
 namespace de {
 namespace filesys {
 
+static dsize const DEFAULT_CHUNK_SIZE = 256 * 1024;
+static int const DEFAULT_CHUNKS_IN_FLIGHT = 4;
+static int const MAX_CHUNK_ATTEMPTS = 3; ///< Requests per chunk before giving up.
+
+/// Completed files are kept in the RemoteFile cache, so the chunk cache only needs to
+/// cover interrupted transfers and content shared between files.
+static dsize const MAX_CHUNK_CACHE_SIZE = 64 * 1024 * 1024;
+
 DENG2_PIMPL(RemoteFeedRelay)
 {
+    /**
+     * File transfer split into chunks. The file's manifest lists the hashes of the
+     * chunks, and chunks already present in the chunk cache are not requested again.
+     * This allows resuming interrupted transfers, and files that share content only
+     * need to be transferred once.
+     */
+    struct ChunkedTransfer
+    {
+        String repository;
+        String path;
+        Request<FileContents> request; ///< Receives the file contents.
+        duint64 fileSize = 0;
+        dsize chunkSize = 0;
+        QList<Block> hashes;
+        QList<int> missing;     ///< Chunks that still need to be requested.
+        QHash<int, int> failedAttempts; ///< Chunks that did not match the manifest.
+        int inFlight = 0;
+        duint64 remainingBytes = 0;
+
+        duint64 chunkOffset(int index) const
+        {
+            return duint64(index) * chunkSize;
+        }
+
+        dsize chunkLength(int index) const
+        {
+            return dsize(de::min(duint64(chunkSize), fileSize - chunkOffset(index)));
+        }
+    };
+    typedef std::shared_ptr<ChunkedTransfer> ChunkedTransferPtr;
+
     std::unique_ptr<QNetworkAccessManager> network;
     QList<Link::Constructor> linkConstructors;
     QHash<String, filesys::Link *> repositories; // owned
+    dsize chunkSize = DEFAULT_CHUNK_SIZE;
+    int maxChunksInFlight = DEFAULT_CHUNKS_IN_FLIGHT;
+    std::unique_ptr<BlockStore> chunkCache;
+    bool chunkCacheOpened = false;
+    QList<Block> chunkUsage;    ///< Cached chunks, least recently used first.
+    dsize chunkCacheSize = 0;   ///< Total size of the cached chunks.
 
     Impl(Public *i) : Base(i)
     {
@@ -63,6 +112,211 @@ DENG2_PIMPL(RemoteFeedRelay)
         qDeleteAll(repositories.values());
     }
 
+    BlockStore *chunks()
+    {
+        if (!chunkCacheOpened)
+        {
+            chunkCacheOpened = true;
+            try
+            {
+                Folder &folder = FS::get().makeFolder(RemoteFile::CACHE_PATH);
+                if (auto *feed = folder.primaryFeedMaybeAs<DirectoryFeed>())
+                {
+                    chunkCache.reset(new BlockStore(feed->nativePath() / "chunks.store"));
+
+                    // The order of use is not persistent; chunks from earlier sessions
+                    // are evicted first.
+                    chunkUsage = chunkCache->keys();
+                    for (Block const &hash : chunkUsage)
+                    {
+                        chunkCacheSize += chunkCache->valueSize(hash);
+                    }
+                    evictChunks();
+                }
+            }
+            catch (Error const &er)
+            {
+                LOG_NET_WARNING("Remote file chunks will not be cached: %s") << er.asText();
+            }
+        }
+        return chunkCache.get();
+    }
+
+    Block cachedChunk(Block const &hash)
+    {
+        if (!chunks()) return Block();
+        Block const data = chunkCache->value(hash);
+        if (!data.isEmpty())
+        {
+            chunkUsage.removeOne(hash);
+            chunkUsage.append(hash);
+        }
+        return data;
+    }
+
+    void storeChunk(Block const &hash, Block const &data)
+    {
+        if (!chunks()) return;
+        if (chunkUsage.removeOne(hash))
+        {
+            chunkCacheSize -= chunkCache->valueSize(hash);
+        }
+        chunkCache->set(hash, data);
+        chunkUsage.append(hash);
+        chunkCacheSize += dsize(data.size());
+        evictChunks();
+    }
+
+    /// Removes the least recently used chunks until the cache fits in its size limit.
+    /// Compaction reclaims the space in the background.
+    void evictChunks()
+    {
+        while (chunkCacheSize > MAX_CHUNK_CACHE_SIZE && !chunkUsage.isEmpty())
+        {
+            Block const hash = chunkUsage.takeFirst();
+            chunkCacheSize -= de::min(chunkCacheSize, chunkCache->valueSize(hash));
+            chunkCache->remove(hash);
+        }
+    }
+
+    void startChunkedTransfer(Link &repo, ChunkedTransferPtr xfer)
+    {
+        DENG2_ASSERT_IN_MAIN_THREAD();
+
+        Request<FileManifest> manifest(new Request<FileManifest>::element_type(
+                [this, xfer] (duint64 fileSize, dsize fileChunkSize, QList<Block> const &hashes)
+        {
+            manifestReceived(xfer, fileSize, fileChunkSize, hashes);
+        }));
+        repo.sendQuery(Query(manifest, xfer->path, chunkSize));
+    }
+
+    void manifestReceived(ChunkedTransferPtr xfer, duint64 fileSize, dsize fileChunkSize,
+                          QList<Block> const &hashes)
+    {
+        if (!xfer->request->isValid()) return; // Cancelled.
+
+        xfer->fileSize       = fileSize;
+        xfer->chunkSize      = de::max(dsize(1), fileChunkSize);
+        xfer->hashes         = hashes;
+        xfer->remainingBytes = fileSize;
+
+        // Before the first chunk, notify about the total size.
+        xfer->request->call(0, Block(), fileSize);
+        if (!fileSize) return;
+
+        if (xfer->chunkOffset(hashes.size()) < fileSize)
+        {
+            LOG_NET_ERROR("Manifest of \"%s\" does not cover the entire file") << xfer->path;
+            xfer->request->cancel();
+            return;
+        }
+
+        // Use the chunks we already have.
+        int cachedCount = 0;
+        for (int i = 0; i < hashes.size(); ++i)
+        {
+            Block const cached = cachedChunk(hashes.at(i));
+            if (dsize(cached.size()) == xfer->chunkLength(i))
+            {
+                deliverChunk(*xfer, xfer->chunkOffset(i), cached);
+                ++cachedCount;
+            }
+            else
+            {
+                xfer->missing << i;
+            }
+        }
+        if (cachedCount)
+        {
+            LOG_NET_MSG("%i of %i chunks of \"%s\" found in the local cache")
+                    << cachedCount << hashes.size() << xfer->path;
+        }
+        requestChunks(xfer);
+    }
+
+    void requestChunks(ChunkedTransferPtr xfer)
+    {
+        auto *repo = repositories.value(xfer->repository);
+        if (!repo || !xfer->request->isValid()) return;
+
+        while (xfer->inFlight < maxChunksInFlight && !xfer->missing.isEmpty())
+        {
+            int const index = xfer->missing.takeFirst();
+            std::shared_ptr<Block> data(new Block(xfer->chunkLength(index)));
+            std::shared_ptr<bool> complete(new bool(false));
+
+            Request<FileContents> chunkRequest(new Request<FileContents>::element_type(
+                    [this, xfer, index, data, complete]
+                    (duint64 startOffset, Block const &chunk, duint64 remainingBytes)
+            {
+                if (*complete) return;
+                if (!chunk.isEmpty())
+                {
+                    duint64 const begin = xfer->chunkOffset(index);
+                    if (startOffset < begin ||
+                        startOffset + chunk.size() > begin + data->size())
+                    {
+                        // Not the requested range; this chunk cannot be verified.
+                        *complete = true;
+                        chunkReceived(xfer, index, Block());
+                        return;
+                    }
+                    data->set(startOffset - begin, chunk.data(), chunk.size());
+                }
+                if (remainingBytes == 0)
+                {
+                    *complete = true;
+                    chunkReceived(xfer, index, *data);
+                }
+            }));
+            repo->sendQuery(Query(chunkRequest, xfer->path,
+                                  xfer->chunkOffset(index), xfer->chunkLength(index)));
+            xfer->inFlight++;
+        }
+    }
+
+    void chunkReceived(ChunkedTransferPtr xfer, int index, Block const &data)
+    {
+        xfer->inFlight--;
+        if (!xfer->request->isValid()) return; // Cancelled.
+
+        if (dsize(data.size()) == xfer->chunkLength(index) &&
+            RemoteFeedManifestPacket::chunkHash(data) == xfer->hashes.at(index))
+        {
+            storeChunk(xfer->hashes.at(index), data);
+            deliverChunk(*xfer, xfer->chunkOffset(index), data);
+        }
+        else if (++xfer->failedAttempts[index] < MAX_CHUNK_ATTEMPTS)
+        {
+            LOG_NET_WARNING("Chunk %i of \"%s\" does not match the manifest; requesting it again")
+                    << index << xfer->path;
+            xfer->missing.prepend(index);
+        }
+        else
+        {
+            // Never deliver data that could not be verified.
+            LOG_NET_ERROR("Chunk %i of \"%s\" did not match the manifest after %i attempts; "
+                          "transfer cancelled")
+                    << index << xfer->path << MAX_CHUNK_ATTEMPTS;
+            xfer->missing.clear();
+            xfer->request->cancel();
+            return;
+        }
+        requestChunks(xfer);
+    }
+
+    void deliverChunk(ChunkedTransfer &xfer, duint64 offset, Block const &data)
+    {
+        xfer.remainingBytes -= de::min(xfer.remainingBytes, duint64(data.size()));
+        xfer.request->call(offset, data, xfer.remainingBytes);
+
+        if (xfer.remainingBytes == 0)
+        {
+            if (auto *cache = chunks()) cache->flush();
+        }
+    }
+
     DENG2_PIMPL_AUDIENCE(Status)
 };
 
@@ -187,13 +441,40 @@ RemoteFeedRelay::fetchFileContents(String const &repository, String filePath, Fi
         // The repository sockets are handled in the main thread.
         auto *repo = d->repositories[repository];
         request.reset(new Request<FileContents>::element_type(contentsReceived));
-        repo->sendQuery(Query(request, filePath));
+        if (repo->supportsChunkedTransfers())
+        {
+            Impl::ChunkedTransferPtr xfer(new Impl::ChunkedTransfer);
+            xfer->repository = repository;
+            xfer->path       = filePath;
+            xfer->request    = request;
+            d->startChunkedTransfer(*repo, xfer);
+        }
+        else
+        {
+            repo->sendQuery(Query(request, filePath));
+        }
         done.post();
     });
     done.wait();
     return request;
 }
 
+void RemoteFeedRelay::setChunkedTransferParameters(dsize chunkSize, int maxChunksInFlight)
+{
+    d->chunkSize         = de::max(dsize(4096), chunkSize);
+    d->maxChunksInFlight = de::max(1, maxChunksInFlight);
+}
+
+dsize RemoteFeedRelay::chunkSize() const
+{
+    return d->chunkSize;
+}
+
+int RemoteFeedRelay::maxChunksInFlight() const
+{
+    return d->maxChunksInFlight;
+}
+
 QNetworkAccessManager &RemoteFeedRelay::network()
 {
     return *d->network;
@@ -422,6 +422,10 @@ public:
      * After loading, you must call glInit() before drawing it. glInit() will be
      * called automatically if needed.
      *
+     * The imported scene is cached in the MetadataBank so that later loads of the
+     * same unmodified file do not need to go through the importer again. The cache
+     * can be disabled with the <tt>-nomodelcache</tt> option.
+     *
      * @param file  Model file to load.
      */
     void load(File const &file);
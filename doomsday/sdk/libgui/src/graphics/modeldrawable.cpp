@@ -29,16 +29,19 @@
 #include <de/GLState>
 #include <de/GLUniform>
 #include <de/Matrix>
+#include <de/MetadataBank>
 #include <de/NativePath>
 #include <de/TextureBank>
 
 #include <assimp/IOStream.hpp>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/LogStream.hpp>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include <assimp/version.h>
 
 #include <array>
 
@@ -184,6 +187,140 @@ struct DefaultImageLoader : public ModelDrawable::IImageLoader
 
 static DefaultImageLoader defaultImageLoader;
 
+/**
+ * Cache for imported model scenes.
+ *
+ * Importing a model with Assimp involves parsing the source format and running
+ * several postprocessing steps (triangulation, tangent space, vertex joining).
+ * The postprocessed scene is exported in Assimp's own binary dump format (assbin)
+ * and kept in the metadata bank, so that subsequent loads of the same (unchanged)
+ * source file only need to read the dump, without any postprocessing.
+ *
+ * The cached scene is read back by the model's Assimp::Importer, which owns the
+ * scene afterwards. This way the scene is always allocated and freed by Assimp.
+ */
+struct SceneCache
+{
+    static String const CATEGORY;
+    static char const *FORMAT_ID;
+
+    /// Version of the cached data. Increment when the import postprocessing steps
+    /// are modified.
+    static duint32 const FORMAT_VERSION = 2;
+
+    static bool isEnabled()
+    {
+        static bool const enabled = !App::commandLine().has("-nomodelcache") &&
+                                    isFormatSupported();
+        return enabled;
+    }
+
+    /**
+     * Checks that Assimp can both write and read the dump format. Either may have
+     * been left out of the Assimp build.
+     */
+    static bool isFormatSupported()
+    {
+        if (!Assimp::Importer().IsExtensionSupported(FORMAT_ID))
+        {
+            LOG_GL_NOTE("Model cache disabled: Assimp cannot import \"%s\"") << FORMAT_ID;
+            return false;
+        }
+        Assimp::Exporter exporter;
+        for (dsize i = 0; i < exporter.GetExportFormatCount(); ++i)
+        {
+            if (!qstrcmp(exporter.GetExportFormatDescription(i)->id, FORMAT_ID))
+            {
+                return true;
+            }
+        }
+        LOG_GL_NOTE("Model cache disabled: Assimp cannot export \"%s\"") << FORMAT_ID;
+        return false;
+    }
+
+    /**
+     * Determines the cache identifier for a model file. Files in the same folder
+     * whose names begin with the model's name (e.g., .mtl and .md5anim files)
+     * are included, because they contribute to the imported scene. The Assimp
+     * version is included, too, because the dump format may change between versions.
+     */
+    static Block cacheId(File const &file)
+    {
+        Block id = md5Hash(CATEGORY, FORMAT_VERSION,
+                           duint32(aiGetVersionMajor()),
+                           duint32(aiGetVersionMinor()),
+                           duint32(aiGetVersionRevision()),
+                           file.metaId());
+        if (Folder const *folder = file.parent())
+        {
+            String const baseName = file.name().fileNameWithoutExtension();
+            folder->forContents([&file, &id, &baseName] (String fileName, File &sibling)
+            {
+                if (&sibling != &file && fileName.startsWith(baseName))
+                {
+                    id = Block(id + sibling.metaId()).md5Hash();
+                }
+                return LoopContinue;
+            });
+        }
+        return id;
+    }
+
+    /**
+     * Attempts to read a previously imported scene from the cache.
+     *
+     * @param id        Cache identifier.
+     * @param importer  Importer that reads the cached scene. It owns the scene
+     *                  afterwards.
+     *
+     * @return The restored scene, or @c nullptr if nothing usable was cached.
+     */
+    static aiScene const *restore(Block const &id, Assimp::Importer &importer)
+    {
+        if (!isEnabled()) return nullptr;
+        try
+        {
+            if (Block const cached = MetadataBank::get().check(CATEGORY, id))
+            {
+                Block const data = cached.decompressed();
+
+                // The cached scene has already been postprocessed.
+                if (aiScene const *scene = importer.ReadFileFromMemory(
+                            data.constData(), data.size(), 0, FORMAT_ID))
+                {
+                    return scene;
+                }
+                LOGDEV_GL_WARNING("Corrupt cached model data: %s") << importer.GetErrorString();
+            }
+        }
+        catch (Error const &er)
+        {
+            LOGDEV_GL_WARNING("Corrupt cached model data: %s") << er.asText();
+        }
+        return nullptr;
+    }
+
+    static void store(Block const &id, aiScene const &scene)
+    {
+        if (!isEnabled()) return;
+
+        Assimp::Exporter exporter;
+        if (aiExportDataBlob const *blob = exporter.ExportToBlob(&scene, FORMAT_ID))
+        {
+            // The blob is owned by the exporter.
+            MetadataBank::get().setMetadata(CATEGORY, id, Block(blob->data, blob->size).compressed());
+        }
+        else
+        {
+            LOGDEV_GL_WARNING("Failed to cache imported model: %s") << exporter.GetErrorString();
+        }
+    }
+};
+
+String const SceneCache::CATEGORY = "ModelDrawable";
+char const *SceneCache::FORMAT_ID = "assbin";
+duint32 const SceneCache::FORMAT_VERSION;
+
 } // namespace internal
 using namespace internal;
 
@@ -673,24 +810,38 @@ DENG2_PIMPL(ModelDrawable)
 #endif
 
         scene = glData.scene = nullptr;
+        importer.FreeScene();
         sourcePath = file.path();
         importerIoSystem->referencePath = sourcePath.fileNamePath();
 
-        // Read the model file and apply suitable postprocessing to clean up the data.
-        if (!importer.ReadFile(sourcePath.toUtf8(),
-                              aiProcess_CalcTangentSpace |
-                              aiProcess_GenSmoothNormals |
-                              aiProcess_JoinIdenticalVertices |
-                              aiProcess_Triangulate |
-                              aiProcess_GenUVCoords |
-                              aiProcess_FlipUVs |
-                              aiProcess_SortByPType))
+        Block const cacheId = SceneCache::cacheId(file);
+        if ((scene = SceneCache::restore(cacheId, importer)) != nullptr)
+        {
+            LOG_GL_VERBOSE("Restored imported scene from cache");
+        }
+        else
         {
-            throw LoadError("ModelDrawable::import", String("Failed to load model from %1: %2")
-                            .arg(file.description()).arg(importer.GetErrorString()));
+            // Read the model file and apply suitable postprocessing to clean up the data.
+            if (!importer.ReadFile(sourcePath.toUtf8(),
+                                  aiProcess_CalcTangentSpace |
+                                  aiProcess_GenSmoothNormals |
+                                  aiProcess_JoinIdenticalVertices |
+                                  aiProcess_Triangulate |
+                                  aiProcess_GenUVCoords |
+                                  aiProcess_FlipUVs |
+                                  aiProcess_SortByPType))
+            {
+                throw LoadError("ModelDrawable::import", String("Failed to load model from %1: %2")
+                                .arg(file.description()).arg(importer.GetErrorString()));
+            }
+
+            scene = importer.GetScene();
+
+            // Next time the model can be loaded without importing.
+            SceneCache::store(cacheId, *scene);
         }
 
-        scene = glData.scene = importer.GetScene();
+        glData.scene = scene;
 
         initBones();
 
@@ -0,0 +1,137 @@
+/**
+ * @file main.cpp
+ *
+ * BlockStore tests: storing, reopening, and compacting a large store.
+ * @ingroup tests
+ *
+ * @author Copyright &copy; 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/TextApp>
+#include <de/BlockStore>
+#include <de/Time>
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+
+using namespace de;
+
+static int const ENTRY_COUNT = 100000;
+
+static Block keyFor(int i)
+{
+    return String("LumpDirectory.%1").arg(i).toUtf8();
+}
+
+static Block valueFor(int i, int generation = 0)
+{
+    return String("metadata %1 generation %2 ").arg(i).arg(generation).toUtf8().repeated(8);
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        TextApp app(argc, argv);
+        app.initSubsystems(App::DisablePlugins);
+
+        NativePath const path = NativePath(QDir::tempPath()) / "test_blockstore.store";
+        QFile::remove(path.toString());
+        QFile::remove(path.toString() + ".index");
+
+        // Populate.
+        {
+            Time const startedAt;
+            BlockStore store(path);
+            for (int i = 0; i < ENTRY_COUNT; ++i)
+            {
+                store.set(keyFor(i), valueFor(i));
+            }
+            qDebug() << "Stored" << ENTRY_COUNT << "entries in"
+                     << startedAt.since().asMilliSeconds() << "ms";
+        }
+
+        // Reopen using the index and look up everything.
+        {
+            Time const startedAt;
+            BlockStore store(path);
+            qDebug() << "Opened with" << store.statistics().entryCount << "entries in"
+                     << startedAt.since().asMilliSeconds() << "ms";
+
+            Time const lookupAt;
+            int mismatches = 0;
+            for (int i = 0; i < ENTRY_COUNT; ++i)
+            {
+                if (store.value(keyFor(i)) != valueFor(i)) ++mismatches;
+            }
+            qDebug() << "Looked up" << ENTRY_COUNT << "entries in"
+                     << lookupAt.since().asMilliSeconds() << "ms, mismatches:" << mismatches;
+
+            // Replace most of the entries to produce garbage; compaction will run in
+            // the background.
+            Time const replaceAt;
+            for (int i = 0; i < ENTRY_COUNT; i += 4)
+            {
+                store.remove(keyFor(i));
+            }
+            for (int i = 1; i < ENTRY_COUNT; i += 4)
+            {
+                store.set(keyFor(i), valueFor(i, 1));
+            }
+            qDebug() << "Replaced entries in" << replaceAt.since().asMilliSeconds() << "ms";
+        }
+
+        // Reopen without the index (full scan), and after compaction.
+        {
+            QFile::remove(path.toString() + ".index");
+
+            Time const startedAt;
+            BlockStore store(path);
+            qDebug() << "Scanned" << store.statistics().entryCount << "entries in"
+                     << startedAt.since().asMilliSeconds() << "ms";
+
+            Time const compactAt;
+            store.compact();
+            auto const stats = store.statistics();
+            qDebug() << "Compacted to" << stats.fileSize << "bytes in"
+                     << compactAt.since().asMilliSeconds() << "ms, garbage:" << stats.garbageSize
+                     << "compactions:" << stats.compactionCount;
+
+            int mismatches = 0;
+            for (int i = 0; i < ENTRY_COUNT; ++i)
+            {
+                Block const expected = (i % 4 == 0? Block() :
+                                        i % 4 == 1? valueFor(i, 1) : valueFor(i));
+                if (store.value(keyFor(i)) != expected) ++mismatches;
+            }
+            qDebug() << "Entries after compaction:" << stats.entryCount
+                     << "mismatches:" << mismatches;
+            qDebug() << "Keys after compaction:" << store.keys().size();
+        }
+
+        QFile::remove(path.toString());
+        QFile::remove(path.toString() + ".index");
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+    }
+
+    qDebug() << "Exiting main()...";
+    return 0;
+}
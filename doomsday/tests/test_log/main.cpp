@@ -19,12 +19,56 @@
 
 #include <de/TextApp>
 #include <de/Log>
+#include <de/LogBuffer>
 #include <de/LogFilter>
 
 #include <QDebug>
+#include <QThread>
 
 using namespace de;
 
+static int const BENCH_THREADS = 4;
+static int const BENCH_ENTRIES = 25000; // per thread
+
+class LogBenchThread : public QThread
+{
+public:
+    LogBenchThread(duint32 metadata) : _metadata(metadata) {}
+
+    void run() override
+    {
+        LOG_AS("LogBenchThread");
+        for (int i = 0; i < BENCH_ENTRIES; ++i)
+        {
+            LOG_AT_LEVEL(_metadata, "Entry %i: %s %f") << i << "argument" << i * .5;
+        }
+    }
+
+private:
+    duint32 _metadata;
+};
+
+/**
+ * Measures the cost of making log entries when several threads are logging at the
+ * same time.
+ */
+static void benchmark(char const *label, duint32 metadata)
+{
+    QList<LogBenchThread *> threads;
+    for (int i = 0; i < BENCH_THREADS; ++i)
+    {
+        threads << new LogBenchThread(metadata);
+    }
+
+    Time const startedAt;
+    for (auto *t : threads) t->start();
+    for (auto *t : threads) t->wait();
+    TimeSpan const elapsed = startedAt.since();
+    qDeleteAll(threads);
+
+    qDebug() << label << ":" << elapsed * 1.0e9 / (BENCH_THREADS * BENCH_ENTRIES) << "ns/entry";
+}
+
 int main(int argc, char **argv)
 {
     try
@@ -59,6 +103,20 @@ int main(int argc, char **argv)
                 }
             }
         }
+
+        // Benchmark with the entries not written to the console.
+        app.logFilter().setAllowDev(false);
+        app.logFilter().setMinLevel(LogEntry::Message);
+        LogBuffer &buf = LogBuffer::get();
+        buf.enableStandardOutput(false);
+
+        benchmark("Filtered out", LogEntry::Generic | LogEntry::XVerbose);
+        benchmark("Synchronous flushing", LogEntry::Generic | LogEntry::Message);
+        buf.enableAsyncFlushing();
+        benchmark("Asynchronous flushing", LogEntry::Generic | LogEntry::Message);
+        buf.enableAsyncFlushing(false);
+
+        buf.enableStandardOutput(true);
     }
     catch (Error const &err)
     {
@@ -0,0 +1,336 @@
+/**
+ * @file main.cpp
+ *
+ * RemoteFeedRelay tests: chunked file transfers over a loopback repository link
+ * that encodes all queries and replies with RemoteFeedProtocol. @ingroup tests
+ *
+ * @author Copyright &copy; 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/TextApp>
+#include <de/RemoteFeedProtocol>
+#include <de/RemoteFeedRelay>
+#include <de/Writer>
+#include <de/filesys/Link>
+
+#include <QDateTime>
+#include <QDebug>
+#include <memory>
+
+using namespace de;
+using namespace de::filesys;
+
+static String const REPOSITORY = "loopback:test";
+static String const FILE_PATH  = "/data/file.bin";
+static dsize const CHUNK_SIZE  = 16 * 1024;
+static dsize const FILE_SIZE   = 10 * CHUNK_SIZE + 1234;
+
+/**
+ * Repository that answers queries in the same process. Queries and replies are
+ * serialized to blocks and interpreted with RemoteFeedProtocol, as they would be
+ * when sent over a socket. Replies are delivered only when deliverReplies() is
+ * called, so they arrive asynchronously with respect to the relay.
+ */
+class LoopbackLink : public Link
+{
+public:
+    Block contents;
+    QHash<duint64, int> corruptReplies; ///< Range offset => number of replies to corrupt.
+    int rangeQueries = 0;
+
+    LoopbackLink(String const &address) : Link(address) {}
+
+    static Link *construct(String const &address)
+    {
+        if (address.startsWith("loopback:")) return new LoopbackLink(address);
+        return nullptr;
+    }
+
+    void setLocalRoot(String const &rootPath) override
+    {
+        Link::setLocalRoot(rootPath);
+        wasConnected();
+    }
+
+    PackagePaths locatePackages(StringList const &) const override
+    {
+        return PackagePaths();
+    }
+
+    LoopResult forPackageIds(std::function<LoopResult (String const &)>) const override
+    {
+        return LoopContinue;
+    }
+
+    bool supportsChunkedTransfers() const override
+    {
+        return true;
+    }
+
+    /**
+     * Delivers all the replies sent so far.
+     * @return Number of replies delivered.
+     */
+    int deliverReplies()
+    {
+        QList<Block> replies;
+        replies.swap(_replies);
+        for (Block const &reply : replies)
+        {
+            std::unique_ptr<Packet> packet(_protocol.interpret(reply));
+            if (!packet) continue;
+
+            switch (_protocol.recognize(*packet))
+            {
+            case RemoteFeedProtocol::Metadata: {
+                auto const &md = packet->as<RemoteFeedMetadataPacket>();
+                metadataReceived(md.id(), md.metadata());
+                break; }
+
+            case RemoteFeedProtocol::FileContents: {
+                auto const &fc = packet->as<RemoteFeedFileContentsPacket>();
+                chunkReceived(fc.id(), fc.startOffset(), fc.data(), fc.fileSize());
+                break; }
+
+            case RemoteFeedProtocol::Manifest: {
+                auto const &mf = packet->as<RemoteFeedManifestPacket>();
+                manifestReceived(mf.id(), mf.fileSize(), mf.chunkSize(), mf.chunkHashes());
+                break; }
+
+            default:
+                break;
+            }
+        }
+        cleanupQueries();
+        return replies.size();
+    }
+
+protected:
+    void transmit(Query const &query) override
+    {
+        // Encode the query like NativeLink does.
+        RemoteFeedQueryPacket packet;
+        packet.setId(query.id);
+        packet.setPath(query.path);
+        if (query.fileMetadata)
+        {
+            packet.setQuery(RemoteFeedQueryPacket::ListFiles);
+        }
+        else if (query.fileManifest)
+        {
+            packet.setQuery(RemoteFeedQueryPacket::FileManifest);
+            packet.setChunkSize(query.chunkSize);
+        }
+        else if (query.rangeSize > 0)
+        {
+            packet.setQuery(RemoteFeedQueryPacket::FileRange);
+            packet.setRange(query.rangeOffset, query.rangeSize);
+        }
+        else
+        {
+            packet.setQuery(RemoteFeedQueryPacket::FileContents);
+        }
+        Block wire;
+        Writer(wire) << packet;
+        answer(wire);
+    }
+
+private:
+    void reply(Packet const &packet)
+    {
+        Block wire;
+        Writer(wire) << packet;
+        _replies << wire;
+    }
+
+    void answer(Block const &wire)
+    {
+        std::unique_ptr<Packet> packet(_protocol.interpret(wire));
+        auto const &query = packet->as<RemoteFeedQueryPacket>();
+
+        switch (query.query())
+        {
+        case RemoteFeedQueryPacket::ListFiles: {
+            RemoteFeedMetadataPacket md;
+            md.setId(query.id());
+            reply(md);
+            break; }
+
+        case RemoteFeedQueryPacket::FileManifest: {
+            QList<Block> hashes;
+            for (dsize pos = 0; pos < contents.size(); pos += query.chunkSize())
+            {
+                hashes << RemoteFeedManifestPacket::chunkHash(
+                              Block(contents, pos, de::min(query.chunkSize(), contents.size() - pos)));
+            }
+            RemoteFeedManifestPacket mf;
+            mf.setId(query.id());
+            mf.setFileSize(contents.size());
+            mf.setChunkSize(query.chunkSize());
+            mf.setChunkHashes(hashes);
+            reply(mf);
+            break; }
+
+        case RemoteFeedQueryPacket::FileRange:
+        case RemoteFeedQueryPacket::FileContents: {
+            duint64 offset = 0;
+            duint64 size   = contents.size();
+            if (query.query() == RemoteFeedQueryPacket::FileRange)
+            {
+                ++rangeQueries;
+                offset = de::min(query.rangeOffset(), duint64(contents.size()));
+                size   = de::min(query.rangeSize(), contents.size() - offset);
+            }
+            Block data(contents, offset, size);
+            if (corruptReplies.value(offset) > 0)
+            {
+                corruptReplies[offset]--;
+                data.data()[data.size() / 2] ^= 0xff;
+            }
+            // Send the data in two parts, like a large reply would be.
+            dsize const half = data.size() / 2;
+            for (dsize pos : { dsize(0), half })
+            {
+                RemoteFeedFileContentsPacket fc;
+                fc.setId(query.id());
+                fc.setStartOffset(offset + pos);
+                fc.setFileSize(data.size());
+                fc.setData(Block(data, pos, pos? data.size() - half : half));
+                reply(fc);
+            }
+            break; }
+        }
+    }
+
+    RemoteFeedProtocol _protocol;
+    QList<Block> _replies;
+};
+
+static Block randomContents()
+{
+    // Different contents on every run, so that previously cached chunks are not used.
+    static duint32 seed = duint32(QDateTime::currentMSecsSinceEpoch());
+    Block data(FILE_SIZE);
+    for (dsize i = 0; i < data.size(); ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        data.data()[i] = dbyte(seed >> 24);
+    }
+    return data;
+}
+
+struct Transfer
+{
+    Block received;
+    QList<duint64> offsets;     ///< Offsets of the delivered parts.
+    bool complete = false;
+    bool cancelled = false;
+};
+
+static Transfer fetch(LoopbackLink &link)
+{
+    Transfer xfer;
+    bool sizeKnown = false;
+    auto request = RemoteFeedRelay::get().fetchFileContents(REPOSITORY, FILE_PATH,
+            [&xfer, &sizeKnown] (duint64 startOffset, Block const &chunk, duint64 remainingBytes)
+    {
+        if (!sizeKnown)
+        {
+            // First call notifies the total size.
+            sizeKnown = true;
+            xfer.received = Block(remainingBytes);
+            return;
+        }
+        xfer.received.set(startOffset, chunk.data(), chunk.size());
+        xfer.offsets << startOffset;
+        if (!remainingBytes) xfer.complete = true;
+    });
+    while (!xfer.complete && request->isValid() && link.deliverReplies() > 0) {}
+    xfer.cancelled = !request->isValid();
+    return xfer;
+}
+
+static void report(char const *scenario, bool ok)
+{
+    qDebug() << scenario << (ok? "OK" : "FAILED");
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        TextApp app(argc, argv);
+        app.initSubsystems(App::DisablePlugins);
+
+        auto &relay = RemoteFeedRelay::get();
+        relay.defineLink(LoopbackLink::construct);
+        relay.setChunkedTransferParameters(CHUNK_SIZE, 4);
+        relay.addRepository(REPOSITORY, "/remote/loopback");
+        auto &link = static_cast<LoopbackLink &>(*relay.repository(REPOSITORY));
+        int const chunkCount = int((FILE_SIZE + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+        // Plain transfer.
+        {
+            link.contents = randomContents();
+            link.rangeQueries = 0;
+            Transfer const xfer = fetch(link);
+            report("Transfer:", xfer.complete && xfer.received == link.contents &&
+                                link.rangeQueries == chunkCount);
+            qDebug() << "  range queries:" << link.rangeQueries << "chunks:" << chunkCount;
+
+            // The same contents are now found in the chunk cache.
+            link.rangeQueries = 0;
+            Transfer const again = fetch(link);
+            report("Cached transfer:", again.complete && again.received == link.contents &&
+                                       link.rangeQueries == 0);
+            qDebug() << "  range queries:" << link.rangeQueries;
+        }
+
+        // A chunk that doesn't match the manifest is requested again.
+        {
+            link.contents = randomContents();
+            link.rangeQueries = 0;
+            link.corruptReplies.insert(2 * CHUNK_SIZE, 1);
+            Transfer const xfer = fetch(link);
+            report("Corrupted reply retried:", xfer.complete && xfer.received == link.contents &&
+                                               link.rangeQueries == chunkCount + 1);
+            qDebug() << "  range queries:" << link.rangeQueries;
+        }
+
+        // A chunk that never matches cancels the transfer, and is never delivered.
+        {
+            link.contents = randomContents();
+            link.rangeQueries = 0;
+            link.corruptReplies.insert(CHUNK_SIZE, 100);
+            Transfer const xfer = fetch(link);
+            report("Unverifiable chunk cancels:", xfer.cancelled && !xfer.complete &&
+                                                  !xfer.offsets.contains(CHUNK_SIZE));
+            qDebug() << "  range queries:" << link.rangeQueries
+                     << "parts delivered:" << xfer.offsets.size();
+            link.corruptReplies.clear();
+        }
+
+        relay.removeRepository(REPOSITORY);
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+    }
+
+    qDebug() << "Exiting main()...";
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file main.cpp
+ *
+ * TaskPool tests: parallel ranges, nested waiting, and continuations.
+ * @ingroup tests
+ *
+ * @author Copyright &copy; 2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/TextApp>
+#include <de/TaskPool>
+#include <de/Time>
+
+#include <QDebug>
+#include <QThread>
+#include <atomic>
+#include <vector>
+
+using namespace de;
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        TextApp app(argc, argv);
+        app.initSubsystems(App::DisablePlugins);
+
+        // Sum over a range.
+        {
+            int const count = 1000000;
+            std::vector<duint64> values(count);
+            TaskPool::parallelFor(count, [&values] (int begin, int end) {
+                for (int i = begin; i < end; ++i) values[i] = duint64(i) * 2;
+            });
+            duint64 sum = 0;
+            for (auto v : values) sum += v;
+            qDebug() << "parallelFor sum:" << sum << "expected:" << duint64(count - 1) * count;
+        }
+
+        // Tasks that wait for tasks of their own.
+        {
+            std::atomic_int leaves { 0 };
+            Time const startedAt;
+            TaskPool outer;
+            for (int i = 0; i < 32; ++i)
+            {
+                outer.start([&leaves] () {
+                    TaskPool inner;
+                    for (int j = 0; j < 32; ++j)
+                    {
+                        inner.start([&leaves] () { leaves++; });
+                    }
+                    inner.waitForDone();
+                });
+            }
+            outer.waitForDone();
+            qDebug() << "Nested tasks:" << int(leaves) << "of" << 32 * 32
+                     << "in" << startedAt.since().asMilliSeconds() << "ms";
+        }
+
+        // Continuations.
+        {
+            std::atomic_int stage { 0 };
+            TaskPool first;
+            TaskPool second;
+            for (int i = 0; i < 8; ++i)
+            {
+                first.start([&stage] () { stage++; });
+            }
+            first.whenDone([&stage, &second] () {
+                second.start([&stage] () { stage += 100; });
+            });
+            first.waitForDone();
+            while (stage < 108) QThread::yieldCurrentThread();
+            second.waitForDone();
+            qDebug() << "Continuation stage:" << int(stage);
+        }
+
+        auto const stats = TaskPool::statistics();
+        qDebug() << "Threads:" << stats.threadCount
+                 << "executed:" << stats.executedTasks
+                 << "stolen:" << stats.stolenTasks
+                 << "max queued:" << stats.maxQueuedTasks;
+    }
+    catch (Error const &err)
+    {
+        qWarning() << err.asText();
+    }
+
+    qDebug() << "Exiting main()...";
+    return 0;
+}